@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Общий бенчмарк всех лабораторных. Каждый файл bench/labN.cpp регистрирует
+// замеры над настоящими реализациями из каталогов лабораторных; генераторы
+// детерминированы и зависят только от seed, имени замера и размера.
+namespace bench {
+
+// Один размер одного замера. setup готовит вход вне замера перед каждым
+// повтором (если вход портится), run — измеряемая часть.
+struct Fixture {
+    std::function<void()> setup;
+    std::function<void()> run;
+    double work = 0; // объём работы за один run в единицах unit
+};
+
+struct Benchmark {
+    std::string name;  // "lab8/hopcroft_karp"
+    std::string unit;  // в чём считать пропускную способность: "items", "bytes", ...
+    std::vector<long long> sizes;
+    std::vector<long long> quickSizes; // для --quick
+    std::function<Fixture(long long n, std::uint64_t seed)> make;
+};
+
+std::vector<Benchmark>& registry();
+
+struct Register {
+    explicit Register(Benchmark b) { registry().push_back(std::move(b)); }
+};
+
+// не даёт компилятору выбросить результат замера
+void keep(std::uint64_t x);
+
+// seed генератора для (общий seed, имя, размер)
+std::uint64_t caseSeed(std::uint64_t seed, const std::string& name, long long n);
+
+} // namespace bench
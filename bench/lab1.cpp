@@ -0,0 +1,36 @@
+#include <memory>
+#include <random>
+
+#include "bench.hpp"
+#include "../lab1/counting_sort.hpp"
+
+namespace {
+
+// ключи 0..MAX_KEY-1, значения — строки из 1..32 строчных букв
+std::vector<Item> makeItems(long long n, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<Item> items(n);
+    for (auto& it : items) {
+        it.key = rng() % MAX_KEY;
+        it.value.resize(1 + rng() % 32);
+        for (char& c : it.value) c = static_cast<char>('a' + rng() % 26);
+    }
+    return items;
+}
+
+bench::Register benchCountingSort({
+    "lab1/counting_sort", "items", {10000, 100000, 1000000, 4000000}, {10000, 100000},
+    [](long long n, std::uint64_t seed) {
+        auto items = std::make_shared<std::vector<Item>>(makeItems(n, seed));
+        auto input = std::make_shared<std::vector<Item>>();
+        bench::Fixture f;
+        f.setup = [=] { *input = *items; };
+        f.run = [=] {
+            std::vector<Item> sorted = countingSort(std::move(*input));
+            bench::keep(sorted.front().key + sorted.back().key);
+        };
+        f.work = static_cast<double>(n);
+        return f;
+    }});
+
+} // namespace
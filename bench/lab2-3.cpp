@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <random>
+
+#include "bench.hpp"
+#include "../lab2-3/TPatriciaTrie.hpp"
+
+namespace {
+
+// n различных слов из 1..16 строчных букв
+std::vector<std::string> makeWords(long long n, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<std::string> words;
+    words.reserve(n);
+    for (long long i = 0; i < n; ++i) {
+        std::string w(1 + rng() % 16, 'a');
+        for (char& c : w) c = static_cast<char>('a' + rng() % 26);
+        words.push_back(std::move(w));
+    }
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    std::shuffle(words.begin(), words.end(), rng);
+    return words;
+}
+
+bench::Register benchInsert({
+    "lab2-3/patricia_insert", "ops", {10000, 100000, 1000000}, {10000},
+    [](long long n, std::uint64_t seed) {
+        auto words = std::make_shared<std::vector<std::string>>(makeWords(n, seed));
+        auto trie = std::make_shared<std::unique_ptr<TPatriciaTrie>>();
+        bench::Fixture f;
+        f.setup = [=] { trie->reset(new TPatriciaTrie()); };
+        f.run = [=] {
+            std::uint64_t ok = 0;
+            for (std::size_t i = 0; i < words->size(); ++i) ok += (*trie)->Insert((*words)[i], i);
+            bench::keep(ok);
+        };
+        f.work = static_cast<double>(words->size());
+        return f;
+    }});
+
+// половина запросов — отсутствующие слова
+bench::Register benchFind({
+    "lab2-3/patricia_find", "ops", {10000, 100000, 1000000}, {10000},
+    [](long long n, std::uint64_t seed) {
+        auto words = std::make_shared<std::vector<std::string>>(makeWords(2 * n, seed));
+        auto trie = std::make_shared<TPatriciaTrie>();
+        for (std::size_t i = 0; i < words->size(); i += 2) trie->Insert((*words)[i], i);
+        bench::Fixture f;
+        f.run = [=] {
+            std::uint64_t sum = 0;
+            for (const std::string& w : *words)
+                if (auto node = trie->Find(w)) sum += node->value;
+            bench::keep(sum);
+        };
+        f.work = static_cast<double>(words->size());
+        return f;
+    }});
+
+bench::Register benchErase({
+    "lab2-3/patricia_erase", "ops", {10000, 100000, 1000000}, {10000},
+    [](long long n, std::uint64_t seed) {
+        auto words = std::make_shared<std::vector<std::string>>(makeWords(n, seed));
+        auto trie = std::make_shared<std::unique_ptr<TPatriciaTrie>>();
+        bench::Fixture f;
+        f.setup = [=] {
+            trie->reset(new TPatriciaTrie());
+            for (std::size_t i = 0; i < words->size(); ++i) (*trie)->Insert((*words)[i], i);
+        };
+        f.run = [=] {
+            std::uint64_t ok = 0;
+            for (const std::string& w : *words) ok += (*trie)->Erase(w);
+            bench::keep(ok);
+        };
+        f.work = static_cast<double>(words->size());
+        return f;
+    }});
+
+// Весь срок жизни бора — вставки и разрушение — в куче, пуле и арене.
+// Разрушение входит в замер: в арене оно не обходит узлы.
+enum class Storage { Heap, Pool, Arena };
+
+bench::Benchmark lifecycle(const char* name, Storage storage) {
+    return {name, "ops", {10000, 100000, 1000000}, {10000},
+            [storage](long long n, std::uint64_t seed) {
+                auto words = std::make_shared<std::vector<std::string>>(makeWords(n, seed));
+                bench::Fixture f;
+                f.run = [=] {
+                    std::uint64_t ok = 0;
+                    auto fill = [&](TPatriciaTrie& trie) {
+                        for (std::size_t i = 0; i < words->size(); ++i) ok += trie.Insert((*words)[i], i);
+                    };
+                    if (storage == Storage::Heap) {
+                        TPatriciaTrie trie;
+                        fill(trie);
+                    } else if (storage == Storage::Pool) {
+                        std::pmr::unsynchronized_pool_resource pool;
+                        TPatriciaTrie trie(&pool);
+                        fill(trie);
+                    } else {
+                        arena::Arena mem(std::size_t(1) << 20);
+                        TPatriciaTrie trie(mem);
+                        fill(trie);
+                    }
+                    bench::keep(ok);
+                };
+                f.work = static_cast<double>(words->size());
+                return f;
+            }};
+}
+
+bench::Register benchLifecycleHeap(lifecycle("lab2-3/patricia_lifecycle_heap", Storage::Heap));
+bench::Register benchLifecyclePool(lifecycle("lab2-3/patricia_lifecycle_pool", Storage::Pool));
+bench::Register benchLifecycleArena(lifecycle("lab2-3/patricia_lifecycle_arena", Storage::Arena));
+
+} // namespace
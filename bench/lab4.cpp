@@ -0,0 +1,36 @@
+#include <memory>
+#include <random>
+
+#include "bench.hpp"
+#include "../lab4/search.hpp"
+
+namespace {
+
+// Текст из n слов над словарём из 64 коротких слов, по 12 слов в строке;
+// образец из трёх слов того же словаря, так что вхождения есть.
+bench::Register benchZSearch({
+    "lab4/z_search", "words", {100000, 1000000, 5000000}, {100000},
+    [](long long n, std::uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        // токены ссылаются на слова словаря, он живёт вместе с замером
+        auto dict = std::make_shared<std::vector<std::string>>(64);
+        for (auto& w : *dict) {
+            w.assign(1 + rng() % 4, 'a');
+            for (char& c : w) c = static_cast<char>('a' + rng() % 3);
+        }
+        auto pattern = std::make_shared<std::vector<std::string>>();
+        for (int i = 0; i < 3; ++i) pattern->push_back((*dict)[rng() % dict->size()]);
+        auto tokens = std::make_shared<std::vector<TToken>>();
+        tokens->reserve(n);
+        for (long long i = 0; i < n; ++i)
+            tokens->push_back({(*dict)[rng() % dict->size()], static_cast<int>(i / 12) + 1, static_cast<int>(i % 12) + 1});
+        bench::Fixture f;
+        f.run = [=] {
+            (void)dict;
+            bench::keep(findPattern(*pattern, *tokens).size());
+        };
+        f.work = static_cast<double>(n);
+        return f;
+    }});
+
+} // namespace
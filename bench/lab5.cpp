@@ -0,0 +1,70 @@
+#include <memory>
+#include <random>
+
+#include "bench.hpp"
+#include "../lab5/suffix_tree.hpp"
+#include "../lab5/suffix_array.hpp"
+
+namespace {
+
+// две случайные строки длины n над алфавитом из четырёх букв
+std::string makeText(long long n, std::uint64_t seed, std::size_t& posDollar) {
+    std::mt19937_64 rng(seed);
+    std::string s(2 * n + 2, 'a');
+    for (long long i = 0; i < n; ++i) s[i] = static_cast<char>('a' + rng() % 4);
+    s[n] = '$';
+    for (long long i = n + 1; i <= 2 * n; ++i) s[i] = static_cast<char>('a' + rng() % 4);
+    s[2 * n + 1] = '#';
+    posDollar = static_cast<std::size_t>(n);
+    return s;
+}
+
+bench::Register benchSuffixTree({
+    "lab5/suffix_tree_lcs", "bytes", {100000, 1000000, 2000000}, {100000},
+    [](long long n, std::uint64_t seed) {
+        std::size_t posDollar = 0;
+        auto text = std::make_shared<std::string>(makeText(n, seed, posDollar));
+        bench::Fixture f;
+        f.run = [=] {
+            SuffixTree st;
+            st.build(*text);
+            auto ans = st.findLCSForTwoStrings(static_cast<int>(posDollar), static_cast<int>(text->size()) - 1);
+            bench::keep(ans.first + ans.second.size());
+        };
+        f.work = static_cast<double>(text->size());
+        return f;
+    }});
+
+// то же в арене: узлы, таблицы переходов и концы рёбер, разрушение без обхода
+bench::Register benchSuffixTreeArena({
+    "lab5/suffix_tree_lcs_arena", "bytes", {100000, 1000000, 2000000}, {100000},
+    [](long long n, std::uint64_t seed) {
+        std::size_t posDollar = 0;
+        auto text = std::make_shared<std::string>(makeText(n, seed, posDollar));
+        bench::Fixture f;
+        f.run = [=] {
+            arena::Arena mem(std::size_t(1) << 20);
+            SuffixTree st(mem);
+            st.build(*text);
+            auto ans = st.findLCSForTwoStrings(static_cast<int>(posDollar), static_cast<int>(text->size()) - 1);
+            bench::keep(ans.first + ans.second.size());
+        };
+        f.work = static_cast<double>(text->size());
+        return f;
+    }});
+
+bench::Register benchSuffixArray({
+    "lab5/suffix_array_lcs", "bytes", {100000, 1000000, 4000000}, {100000},
+    [](long long n, std::uint64_t seed) {
+        std::size_t posDollar = 0;
+        auto text = std::make_shared<std::string>(makeText(n, seed, posDollar));
+        bench::Fixture f;
+        f.run = [=] {
+            auto ans = sa::findLCS(*text, posDollar, 1);
+            bench::keep(ans.first + ans.second.size());
+        };
+        f.work = static_cast<double>(text->size());
+        return f;
+    }});
+
+} // namespace
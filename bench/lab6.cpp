@@ -0,0 +1,22 @@
+#include <memory>
+
+#include "bench.hpp"
+#include "../lab6/dp_kernel.hpp"
+
+namespace {
+
+bench::Register benchDpFill({
+    "lab6/dp_fill", "values", {1000000, 10000000, 100000000}, {1000000},
+    [](long long n, std::uint64_t) {
+        auto dp = std::make_shared<std::vector<long long>>(n + 1);
+        auto op = std::make_shared<std::vector<unsigned char>>(n + 1);
+        bench::Fixture f;
+        f.run = [=] {
+            dpk::fill(dp->data(), op->data(), 1, static_cast<int>(n));
+            bench::keep((*dp)[n]);
+        };
+        f.work = static_cast<double>(n);
+        return f;
+    }});
+
+} // namespace
@@ -0,0 +1,86 @@
+#include <memory>
+#include <random>
+
+#include "bench.hpp"
+#include "../lab7/var2/cover.hpp"
+
+namespace {
+
+// n отрезков внутри [-M/2, 3M/2] длиной до 4M/n, M = 10^6: покрытие [0, M] есть
+std::vector<Seg> makeSegs(long long n, std::mt19937_64& rng, int M) {
+    std::vector<Seg> segs(n);
+    const long long maxLen = std::max<long long>(2, 4LL * M / n);
+    for (long long i = 0; i < n; ++i) {
+        int L = static_cast<int>(rng() % (2 * M)) - M / 2;
+        segs[i] = {L, L + static_cast<int>(rng() % maxLen), static_cast<int>(i)};
+    }
+    return segs;
+}
+
+constexpr int M = 1000000;
+
+bench::Register benchGreedy({
+    "lab7/var2/greedy_cover", "segments", {100000, 1000000, 10000000}, {100000},
+    [](long long n, std::uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        auto segs = std::make_shared<std::vector<Seg>>(makeSegs(n, rng, M));
+        auto input = std::make_shared<std::vector<Seg>>();
+        bench::Fixture f;
+        f.setup = [=] { *input = *segs; };
+        f.run = [=] {
+            radix_sort_by_L(*input);
+            std::vector<Seg> res;
+            if (greedy_cover_sorted(*input, M, res)) bench::keep(order_by_idx(res, static_cast<int>(n)).size());
+        };
+        f.work = static_cast<double>(n);
+        return f;
+    }});
+
+// построение индекса и n запросов со случайными [a, b]
+bench::Register benchQueries({
+    "lab7/var2/cover_index", "queries", {100000, 1000000}, {100000},
+    [](long long n, std::uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        auto segs = std::make_shared<std::vector<Seg>>(makeSegs(n, rng, M));
+        auto qs = std::make_shared<std::vector<std::pair<int, int>>>(n);
+        for (auto& q : *qs) {
+            q.first = static_cast<int>(rng() % M);
+            q.second = q.first + static_cast<int>(rng() % (M - q.first + 1));
+        }
+        bench::Fixture f;
+        f.run = [=] {
+            CoverIndex index(*segs);
+            long long sum = 0;
+            for (auto& q : *qs) sum += index.query(q.first, q.second);
+            bench::keep(static_cast<std::uint64_t>(sum));
+        };
+        f.work = static_cast<double>(n);
+        return f;
+    }});
+
+// n вставок вперемешку с удалениями и запросом покрытия на каждую сотню операций
+bench::Register benchDynamic({
+    "lab7/var2/dynamic_cover", "ops", {10000, 100000, 1000000}, {10000},
+    [](long long n, std::uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        auto segs = std::make_shared<std::vector<Seg>>(makeSegs(n, rng, M));
+        bench::Fixture f;
+        f.run = [=] {
+            DynamicCover set;
+            std::vector<Seg> res;
+            std::uint64_t sum = 0;
+            for (long long i = 0; i < n; ++i) {
+                set.insert((*segs)[i]);
+                if (i % 4 == 3) set.erase((*segs)[i - 2]);
+                if (i % 100 == 99) {
+                    res.clear();
+                    if (set.cover(M, res)) sum += res.size();
+                }
+            }
+            bench::keep(sum);
+        };
+        f.work = static_cast<double>(n);
+        return f;
+    }});
+
+} // namespace
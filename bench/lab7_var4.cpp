@@ -0,0 +1,84 @@
+#include <memory>
+#include <random>
+
+#include "bench.hpp"
+#include "../lab7/var4/basis.hpp"
+
+namespace {
+
+// n кандидатов по 50 столбцов. Все, кроме последнего, — комбинации 49
+// базисных строк, так что полный ранг набирается только в конце и каждый
+// кандидат сводится по всему базису.
+std::shared_ptr<std::vector<std::vector<int>>> makeRows(long long n, int cols, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    auto rows = std::make_shared<std::vector<std::vector<int>>>(n, std::vector<int>(cols));
+    std::vector<std::vector<int>> base(cols - 1, std::vector<int>(cols));
+    for (auto& r : base)
+        for (int& x : r) x = static_cast<int>(rng() % 21) - 10;
+    for (auto& r : *rows)
+        for (const auto& b : base) {
+            int c = static_cast<int>(rng() % 3) - 1;
+            for (int j = 0; j < cols; ++j) r[j] += c * b[j];
+        }
+    for (int& x : rows->back()) x = static_cast<int>(rng() % 21) - 10;
+    return rows;
+}
+
+// Жадный отбор строк в порядке цены точным ModularBasis.
+bench::Register benchBasis({
+    "lab7/var4/modular_basis", "rows", {1000, 10000, 100000}, {1000},
+    [](long long n, std::uint64_t seed) {
+        const int cols = 50;
+        auto rows = makeRows(n, cols, seed);
+        bench::Fixture f;
+        f.run = [=] {
+            ModularBasis b(cols);
+            for (const auto& r : *rows)
+                if (b.try_add(r) && b.rank() == cols) break;
+            bench::keep(b.rank());
+        };
+        f.work = static_cast<double>(n);
+        return f;
+    }});
+
+// Тот же отбор одним векторизованным исключением (main --dense).
+bench::Register benchDense({
+    "lab7/var4/select_dense", "rows", {1000, 10000, 100000}, {1000},
+    [](long long n, std::uint64_t seed) {
+        const int cols = 50;
+        auto rows = makeRows(n, cols, seed);
+        auto cand = std::make_shared<std::vector<const std::vector<int>*>>();
+        for (const auto& r : *rows) cand->push_back(&r);
+        bench::Fixture f;
+        f.run = [=] {
+            static_cast<void>(rows); // cand указывает в rows
+            bench::keep(select_dense(*cand, cols).size());
+        };
+        f.work = static_cast<double>(n);
+        return f;
+    }});
+
+// Параллельный отбор окнами (main --threads) на 2 потоках: маленькое окно —
+// много коротких раундов, где важна цена запуска раунда, большое — мало длинных.
+void registerScreen(const char* name, int window) {
+    bench::Register({
+        name, "rows", {1000, 10000, 100000}, {1000},
+        [window](long long n, std::uint64_t seed) {
+            const int cols = 50;
+            auto rows = makeRows(n, cols, seed);
+            auto cand = std::make_shared<std::vector<const std::vector<int>*>>();
+            for (const auto& r : *rows) cand->push_back(&r);
+            bench::Fixture f;
+            f.run = [=] {
+                static_cast<void>(rows);
+                bench::keep(screen_parallel(*cand, cols, 2, window).size());
+            };
+            f.work = static_cast<double>(n);
+            return f;
+        }});
+}
+
+const bool screenRegistered = (registerScreen("lab7/var4/screen_w2", 2),
+                               registerScreen("lab7/var4/screen_w256", 256), true);
+
+} // namespace
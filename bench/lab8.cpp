@@ -0,0 +1,124 @@
+#include <memory>
+#include <memory_resource>
+#include <random>
+
+#include "bench.hpp"
+#include "../lab8/matching.hpp"
+#include "../lab8/dynamic_matching.hpp"
+#include "../lab8/assignment.hpp"
+
+namespace {
+
+// Левые 1..nL, правые nL+1..2nL, у каждой левой три случайных соседа.
+std::vector<std::pair<int, int>> makeEdges(int nL, std::mt19937_64& rng) {
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(3 * static_cast<std::size_t>(nL));
+    for (int i = 1; i <= nL; ++i)
+        for (int k = 0; k < 3; ++k) edges.emplace_back(i, nL + 1 + static_cast<int>(rng() % nL));
+    return edges;
+}
+
+struct Input {
+    Graph g;
+    std::vector<int> lefts;
+};
+
+std::shared_ptr<Input> makeInput(long long n, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    auto in = std::make_shared<Input>();
+    int nL = static_cast<int>(n);
+    in->g = build_graph(2 * nL + 1, makeEdges(nL, rng));
+    for (int v = 1; v <= nL; ++v) in->lefts.push_back(v);
+    return in;
+}
+
+bench::Register benchKuhn({
+    "lab8/kuhn", "vertices", {10000, 100000}, {10000},
+    [](long long n, std::uint64_t seed) {
+        auto in = makeInput(n, seed);
+        bench::Fixture f;
+        f.run = [=] {
+            std::vector<int> matchR;
+            KuhnOptions opt;
+            opt.warmStart = opt.epochMarks = true;
+            bench::keep(Kuhn(in->g, matchR, opt).run(in->lefts));
+        };
+        f.work = static_cast<double>(2 * n);
+        return f;
+    }});
+
+bench::Register benchHopcroftKarp({
+    "lab8/hopcroft_karp", "vertices", {100000, 1000000}, {100000},
+    [](long long n, std::uint64_t seed) {
+        auto in = makeInput(n, seed);
+        bench::Fixture f;
+        f.run = [=] {
+            std::vector<int> matchR;
+            bench::keep(HopcroftKarp(in->g, in->lefts, matchR).run());
+        };
+        f.work = static_cast<double>(2 * n);
+        return f;
+    }});
+
+// рёбра добавляются по одному, паросочетание поддерживается максимальным
+bench::Register benchDynamic({
+    "lab8/dynamic_matching", "edges", {1000, 10000}, {1000},
+    [](long long n, std::uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        auto edges = std::make_shared<std::vector<std::pair<int, int>>>(makeEdges(static_cast<int>(n), rng));
+        bench::Fixture f;
+        f.run = [=] {
+            DynamicMatching dm(2 * static_cast<int>(n) + 1);
+            for (auto& e : *edges) dm.addEdge(e.first, e.second);
+            bench::keep(dm.size());
+        };
+        f.work = static_cast<double>(edges->size());
+        return f;
+    }});
+
+// то же, списки соседей из пула
+bench::Register benchDynamicPool({
+    "lab8/dynamic_matching_pool", "edges", {1000, 10000}, {1000},
+    [](long long n, std::uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        auto edges = std::make_shared<std::vector<std::pair<int, int>>>(makeEdges(static_cast<int>(n), rng));
+        bench::Fixture f;
+        f.run = [=] {
+            std::pmr::unsynchronized_pool_resource pool;
+            DynamicMatching dm(2 * static_cast<int>(n) + 1, &pool);
+            for (auto& e : *edges) dm.addEdge(e.first, e.second);
+            bench::keep(dm.size());
+        };
+        f.work = static_cast<double>(edges->size());
+        return f;
+    }});
+
+// полный двудольный граф n x n со случайными весами
+bench::Register benchHungarianDense({
+    "lab8/hungarian", "cells", {100, 300, 1000}, {100},
+    [](long long n, std::uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        auto edges = std::make_shared<std::vector<WeightedEdge>>();
+        for (int l = 0; l < n; ++l)
+            for (int r = 0; r < n; ++r) edges->push_back({l, r, static_cast<long long>(rng() % 1000000)});
+        bench::Fixture f;
+        f.run = [=] { bench::keep(hungarian(static_cast<int>(n), static_cast<int>(n), *edges).cost); };
+        f.work = static_cast<double>(n * n);
+        return f;
+    }});
+
+// разреженный граф со случайными весами, по три ребра у левой вершины
+bench::Register benchAuctionSparse({
+    "lab8/auction", "edges", {10000, 100000}, {10000},
+    [](long long n, std::uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        auto edges = std::make_shared<std::vector<WeightedEdge>>();
+        for (auto& e : makeEdges(static_cast<int>(n), rng))
+            edges->push_back({e.first - 1, e.second - 1 - static_cast<int>(n), static_cast<long long>(rng() % 1000000)});
+        bench::Fixture f;
+        f.run = [=] { bench::keep(auction(static_cast<int>(n), static_cast<int>(n), *edges).cost); };
+        f.work = static_cast<double>(edges->size());
+        return f;
+    }});
+
+} // namespace
@@ -0,0 +1,310 @@
+// Общий бенчмарк лабораторных: медиана и p99 времени, пропускная способность,
+// пиковый RSS и число выделений памяти для каждого замера и размера, в JSON.
+//
+// Сборка: cmake --build build --target bench
+//     или g++ -O2 -std=c++17 -pthread bench/*.cpp -o bench/bench
+//
+//   bench [--quick] [--filter S] [--seed N] [--min-time SEC] [--max-reps N]
+//         [--out FILE] [--compare OLD.json] [--threshold R] [--list]
+//
+// Каждый размер каждого замера идёт в отдельном процессе, поэтому пиковый RSS
+// относится только к нему. --compare сравнивает медианы с прошлым прогоном и
+// возвращает код 3, если какой-то замер медленнее в R раз (по умолчанию 1.10).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "bench.hpp"
+
+// Подсчёт выделений: все operator new в процессе (и обычный, и выровненный)
+// проходят через эти счётчики.
+static std::atomic<std::uint64_t> allocCount{0}, allocBytes{0};
+
+void* operator new(std::size_t n) {
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(n, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+// через выровненный new идёт std::pmr::new_delete_resource, а с ним пулы и арены
+void* operator new(std::size_t n, std::align_val_t al) {
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(n, std::memory_order_relaxed);
+    std::size_t a = std::max(static_cast<std::size_t>(al), sizeof(void*));
+    void* p = nullptr;
+    if (::posix_memalign(&p, a, n ? n : 1) == 0) return p;
+    throw std::bad_alloc();
+}
+
+// GCC принимает free здесь за парную ошибку к new, хотя память из malloc выше
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace bench {
+
+std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> all;
+    return all;
+}
+
+static volatile std::uint64_t sink;
+
+void keep(std::uint64_t x) { sink = sink + x; }
+
+std::uint64_t caseSeed(std::uint64_t seed, const std::string& name, long long n) {
+    // FNV-1a по имени, затем перемешивание splitmix64
+    std::uint64_t h = 1469598103934665603ULL ^ seed;
+    for (unsigned char c : name) h = (h ^ c) * 1099511628211ULL;
+    h ^= static_cast<std::uint64_t>(n) + 0x9e3779b97f4a7c15ULL;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+}
+
+} // namespace bench
+
+struct Options {
+    bool quick = false;
+    bool list = false;
+    std::string filter;
+    std::uint64_t seed = 1;
+    double minTime = 1.0;
+    int minReps = 3;
+    int maxReps = 101;
+    std::string out;
+    std::string compare;
+    double threshold = 1.10;
+};
+
+struct Result {
+    std::string name, unit;
+    long long size = 0;
+    int reps = 0;
+    double medianMs = 0, p99Ms = 0, throughput = 0;
+    std::uint64_t allocs = 0, bytes = 0;
+    long peakRssKb = 0;
+    bool ok = false;
+};
+
+// Повторы в дочернем процессе; результат — одна строка в fd.
+static void runChild(const bench::Benchmark& b, long long n, const Options& opt, int fd) {
+    bench::Fixture f = b.make(n, bench::caseSeed(opt.seed, b.name, n));
+    std::vector<double> ms;
+    std::uint64_t allocs = 0, bytes = 0;
+    double total = 0;
+    while (static_cast<int>(ms.size()) < opt.maxReps &&
+           (static_cast<int>(ms.size()) < opt.minReps || total < opt.minTime)) {
+        if (f.setup) f.setup();
+        std::uint64_t a0 = allocCount.load(), b0 = allocBytes.load();
+        auto t0 = std::chrono::steady_clock::now();
+        f.run();
+        auto t1 = std::chrono::steady_clock::now();
+        if (ms.empty()) {
+            allocs = allocCount.load() - a0;
+            bytes = allocBytes.load() - b0;
+        }
+        double d = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        ms.push_back(d);
+        total += d / 1000;
+    }
+    std::sort(ms.begin(), ms.end());
+    std::size_t k = ms.size();
+    double median = k % 2 ? ms[k / 2] : (ms[k / 2 - 1] + ms[k / 2]) / 2;
+    double p99 = ms[static_cast<std::size_t>(std::ceil(0.99 * k)) - 1];
+    char line[256];
+    int len = std::snprintf(line, sizeof(line), "%zu %.6f %.6f %.6g %llu %llu\n", k, median, p99, f.work,
+                            static_cast<unsigned long long>(allocs), static_cast<unsigned long long>(bytes));
+    if (::write(fd, line, len) != len) std::_Exit(1);
+}
+
+static Result runCase(const bench::Benchmark& b, long long n, const Options& opt) {
+    Result r;
+    r.name = b.name;
+    r.unit = b.unit + "/s";
+    r.size = n;
+
+    int fds[2];
+    if (::pipe(fds) != 0) return r;
+    std::fflush(nullptr);
+    pid_t pid = ::fork();
+    if (pid == 0) {
+        ::close(fds[0]);
+        runChild(b, n, opt, fds[1]);
+        // обычный exit: инструментированная сборка (PGO, gcov) пишет профиль при выходе
+        std::exit(0);
+    }
+    ::close(fds[1]);
+    std::string text;
+    char buf[256];
+    for (ssize_t got; (got = ::read(fds[0], buf, sizeof(buf))) > 0;) text.append(buf, got);
+    ::close(fds[0]);
+
+    int status = 0;
+    struct rusage ru;
+    if (pid < 0 || ::wait4(pid, &status, 0, &ru) < 0) return r;
+    r.peakRssKb = ru.ru_maxrss;
+
+    std::istringstream in(text);
+    double work = 0;
+    unsigned long long allocs = 0, bytes = 0;
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+        (in >> r.reps >> r.medianMs >> r.p99Ms >> work >> allocs >> bytes)) {
+        r.allocs = allocs;
+        r.bytes = bytes;
+        r.throughput = r.medianMs > 0 ? work / (r.medianMs / 1000) : 0;
+        r.ok = true;
+    }
+    return r;
+}
+
+static std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        out.push_back(c);
+    }
+    return out;
+}
+
+static void writeJson(std::ostream& os, const std::vector<Result>& all, const Options& opt) {
+    os << "{\n  \"seed\": " << opt.seed << ",\n  \"quick\": " << (opt.quick ? "true" : "false")
+       << ",\n  \"results\": [\n";
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        const Result& r = all[i];
+        char line[512];
+        std::snprintf(line, sizeof(line),
+                      "    {\"name\": \"%s\", \"size\": %lld, \"ok\": %s, \"reps\": %d, \"median_ms\": %.4f, "
+                      "\"p99_ms\": %.4f, \"throughput\": %.6g, \"unit\": \"%s\", \"peak_rss_kb\": %ld, "
+                      "\"allocs\": %llu, \"alloc_bytes\": %llu}%s\n",
+                      jsonEscape(r.name).c_str(), r.size, r.ok ? "true" : "false", r.reps, r.medianMs, r.p99Ms,
+                      r.throughput, jsonEscape(r.unit).c_str(), r.peakRssKb,
+                      static_cast<unsigned long long>(r.allocs), static_cast<unsigned long long>(r.bytes),
+                      i + 1 < all.size() ? "," : "");
+        os << line;
+    }
+    os << "  ]\n}\n";
+}
+
+// Медианы прошлого прогона: по строке на результат, как пишет writeJson.
+static std::map<std::pair<std::string, long long>, double> readBaseline(const std::string& path) {
+    std::map<std::pair<std::string, long long>, double> base;
+    std::ifstream in(path);
+    std::string line;
+    auto field = [&](const char* key) -> std::string {
+        std::size_t p = line.find(key);
+        if (p == std::string::npos) return "";
+        p += std::strlen(key);
+        std::size_t e = line.find_first_of(",}", p);
+        std::string v = line.substr(p, e - p);
+        v.erase(std::remove(v.begin(), v.end(), '"'), v.end());
+        return v;
+    };
+    while (std::getline(in, line)) {
+        std::string name = field("\"name\": "), size = field("\"size\": "), med = field("\"median_ms\": ");
+        if (name.empty() || size.empty() || med.empty() || field("\"ok\": ") != "true") continue;
+        base[{name, std::stoll(size)}] = std::stod(med);
+    }
+    return base;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "missing value for " << a << "\n";
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+        if (a == "--quick") opt.quick = true;
+        else if (a == "--list") opt.list = true;
+        else if (a == "--filter") opt.filter = next();
+        else if (a == "--seed") opt.seed = std::stoull(next());
+        else if (a == "--min-time") opt.minTime = std::stod(next());
+        else if (a == "--max-reps") opt.maxReps = std::max(1, std::stoi(next()));
+        else if (a == "--out") opt.out = next();
+        else if (a == "--compare") opt.compare = next();
+        else if (a == "--threshold") opt.threshold = std::stod(next());
+        else {
+            std::cerr << "unknown option " << a << "\n";
+            return 1;
+        }
+    }
+    opt.minReps = std::min(opt.minReps, opt.maxReps);
+
+    auto& all = bench::registry();
+    std::sort(all.begin(), all.end(), [](const bench::Benchmark& a, const bench::Benchmark& b) { return a.name < b.name; });
+
+    std::vector<Result> results;
+    for (const auto& b : all) {
+        if (b.name.find(opt.filter) == std::string::npos) continue;
+        for (long long n : opt.quick ? b.quickSizes : b.sizes) {
+            if (opt.list) {
+                std::cout << b.name << " " << n << "\n";
+                continue;
+            }
+            Result r = runCase(b, n, opt);
+            if (r.ok) {
+                std::fprintf(stderr, "%-28s n=%-10lld median %10.3f ms  p99 %10.3f ms  %10.3g %s  rss %8ld KB  %llu allocs\n",
+                             r.name.c_str(), n, r.medianMs, r.p99Ms, r.throughput, r.unit.c_str(), r.peakRssKb,
+                             static_cast<unsigned long long>(r.allocs));
+            } else {
+                std::fprintf(stderr, "%-28s n=%-10lld FAILED\n", r.name.c_str(), n);
+            }
+            results.push_back(r);
+        }
+    }
+    if (opt.list) return 0;
+
+    if (opt.out.empty()) {
+        writeJson(std::cout, results, opt);
+    } else {
+        std::ofstream f(opt.out);
+        writeJson(f, results, opt);
+    }
+
+    int rc = 0;
+    for (const Result& r : results)
+        if (!r.ok) rc = 2;
+    if (!opt.compare.empty()) {
+        auto base = readBaseline(opt.compare);
+        std::fprintf(stderr, "\n%-28s %10s %12s %12s %8s\n", "name", "size", "old_ms", "new_ms", "ratio");
+        for (const Result& r : results) {
+            auto it = base.find({r.name, r.size});
+            if (!r.ok || it == base.end() || it->second <= 0) continue;
+            double ratio = r.medianMs / it->second;
+            bool slow = ratio > opt.threshold;
+            std::fprintf(stderr, "%-28s %10lld %12.3f %12.3f %7.2fx%s\n", r.name.c_str(), r.size, it->second,
+                         r.medianMs, ratio, slow ? "  REGRESSION" : "");
+            if (slow && rc == 0) rc = 3;
+        }
+    }
+    return rc;
+}
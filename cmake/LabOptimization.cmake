@@ -0,0 +1,71 @@
+# Общие флаги оптимизации для всех целей: -march=native, LTO и PGO.
+#
+# PGO в два прохода в одном или разных каталогах сборки:
+#   cmake -S . -B build-gen -DLAB_PGO=GENERATE && cmake --build build-gen --target pgo-train
+#   cmake -S . -B build -DLAB_PGO=USE && cmake --build build
+# Профиль лежит в LAB_PGO_DIR. GCC называет файлы профиля по пути объектника,
+# поэтому путь считается от каталога сборки (-fprofile-prefix-path) — так
+# профиль из build-gen подходит и для build. Clang сливает сырые профили в
+# один файл через llvm-profdata (это делает cmake/pgo_train.sh).
+include_guard(GLOBAL)
+include(CheckIPOSupported)
+
+option(LAB_NATIVE "Optimize for the build machine (-march=native)" ON)
+option(LAB_LTO "Link-time optimization" OFF)
+set(LAB_PGO "OFF" CACHE STRING "Profile-guided optimization: OFF, GENERATE or USE")
+set_property(CACHE LAB_PGO PROPERTY STRINGS OFF GENERATE USE)
+set(LAB_PGO_DIR "${CMAKE_SOURCE_DIR}/_pgo" CACHE PATH "Directory for PGO profiles")
+
+string(TOUPPER "${LAB_PGO}" LAB_PGO)
+if(NOT LAB_PGO MATCHES "^(OFF|GENERATE|USE)$")
+  message(FATAL_ERROR "LAB_PGO must be OFF, GENERATE or USE, got '${LAB_PGO}'")
+endif()
+
+set(lab_opt_flags "")
+set(lab_link_flags "")
+if(LAB_NATIVE)
+  list(APPEND lab_opt_flags -march=native)
+endif()
+
+if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+  set(lab_pgo_prefix "-fprofile-prefix-path=${CMAKE_BINARY_DIR}")
+  if(LAB_PGO STREQUAL "GENERATE")
+    list(APPEND lab_opt_flags "-fprofile-generate=${LAB_PGO_DIR}" "${lab_pgo_prefix}" -fprofile-update=atomic)
+    list(APPEND lab_link_flags "-fprofile-generate=${LAB_PGO_DIR}")
+  elseif(LAB_PGO STREQUAL "USE")
+    # режимы, которые обучение не задело, оптимизируются как без профиля
+    list(APPEND lab_opt_flags "-fprofile-use=${LAB_PGO_DIR}" "${lab_pgo_prefix}"
+         -fprofile-partial-training -fprofile-correction -Wno-missing-profile)
+    list(APPEND lab_link_flags "-fprofile-use=${LAB_PGO_DIR}")
+  endif()
+elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+  if(LAB_PGO STREQUAL "GENERATE")
+    list(APPEND lab_opt_flags "-fprofile-instr-generate=${LAB_PGO_DIR}/%m-%p.profraw")
+    list(APPEND lab_link_flags "-fprofile-instr-generate=${LAB_PGO_DIR}/%m-%p.profraw")
+  elseif(LAB_PGO STREQUAL "USE")
+    list(APPEND lab_opt_flags "-fprofile-instr-use=${LAB_PGO_DIR}/merged.profdata" -Wno-profile-instr-unprofiled)
+  endif()
+elseif(NOT LAB_PGO STREQUAL "OFF")
+  message(FATAL_ERROR "LAB_PGO is supported only for GCC and Clang")
+endif()
+
+if(LAB_PGO STREQUAL "GENERATE")
+  file(MAKE_DIRECTORY "${LAB_PGO_DIR}")
+endif()
+
+if(LAB_LTO)
+  check_ipo_supported(RESULT lab_ipo_ok OUTPUT lab_ipo_msg LANGUAGES CXX)
+  if(NOT lab_ipo_ok)
+    message(FATAL_ERROR "LTO is not supported: ${lab_ipo_msg}")
+  endif()
+endif()
+
+message(STATUS "Labs: ${CMAKE_BUILD_TYPE}, native=${LAB_NATIVE}, LTO=${LAB_LTO}, PGO=${LAB_PGO}")
+
+function(lab_optimize target)
+  target_compile_options(${target} PRIVATE ${lab_opt_flags})
+  target_link_options(${target} PRIVATE ${lab_link_flags})
+  if(LAB_LTO)
+    set_property(TARGET ${target} PROPERTY INTERPROCEDURAL_OPTIMIZATION TRUE)
+  endif()
+endfunction()
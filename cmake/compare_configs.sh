@@ -0,0 +1,53 @@
+#!/usr/bin/env bash
+# Сравнение конфигураций сборки: Release, LTO, PGO и PGO+LTO. Каждая собирается
+# в свой каталог OUT/<имя>, PGO обучается на OUT/pgo-gen. Затем каждая
+# программа запускается на своём входе из common/workloads.sh; печатается
+# медиана времени и ускорение относительно Release, ответы сверяются побайтно.
+#
+#   cmake/compare_configs.sh [OUT] [RUNS]
+set -euo pipefail
+
+root=$(cd "$(dirname "$0")/.." && pwd)
+out=$(mkdir -p "${1:-$root/_cfg_build}" && cd "${1:-$root/_cfg_build}" && pwd)
+runs=${2:-3}
+jobs=$(nproc)
+profile="$out/profile"
+source "$root/common/workloads.sh"
+
+configure() {
+  local dir=$1; shift
+  cmake -S "$root" -B "$out/$dir" -DCMAKE_BUILD_TYPE=Release -DLAB_PGO_DIR="$profile" "$@" > /dev/null
+  cmake --build "$out/$dir" -j"$jobs" > /dev/null
+}
+
+rm -rf "$profile"
+configure release
+configure lto -DLAB_LTO=ON
+configure pgo-gen -DLAB_PGO=GENERATE
+cmake --build "$out/pgo-gen" --target pgo-train > /dev/null
+configure pgo -DLAB_PGO=USE
+configure pgo-lto -DLAB_PGO=USE -DLAB_LTO=ON
+
+configs=(release lto pgo pgo-lto)
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+printf '%-10s' binary
+for c in "${configs[@]}"; do printf ' %10s' "${c}_ms"; done
+for c in "${configs[@]:1}"; do printf ' %9s' "$c"; done
+echo
+for w in "${LAB_WORKLOADS[@]}"; do
+  IFS='|' read -r target src args gen <<< "$w"
+  $gen > "$work/in"
+  ms=()
+  for c in "${configs[@]}"; do
+    ms+=($(time_ms "$out/$c/$target" "$args" "$work/in" "$work/$c.out" "$runs"))
+    cmp -s "$work/release.out" "$work/$c.out" || { echo "$target: $c output differs" >&2; exit 1; }
+  done
+  printf '%-10s' "$target"
+  for t in "${ms[@]}"; do printf ' %10d' "$t"; done
+  for t in "${ms[@]:1}"; do
+    awk -v b="${ms[0]}" -v a="$t" 'BEGIN { if (a < 1) a = 1; printf " %8.2fx", b / a }'
+  done
+  echo
+done
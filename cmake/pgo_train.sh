@@ -0,0 +1,38 @@
+#!/usr/bin/env bash
+# Обучающий прогон для PGO: каждая программа на входах из common/workloads.sh
+# (основной режим и остальные режимы из LAB_TRAINING_EXTRA) и bench --quick.
+# Вызывается целью pgo-train инструментированной сборки (-DLAB_PGO=GENERATE).
+#
+#   cmake/pgo_train.sh BIN_DIR
+set -euo pipefail
+
+root=$(cd "$(dirname "$0")/.." && pwd)
+bin=${1:?usage: pgo_train.sh BIN_DIR}
+source "$root/common/workloads.sh"
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+run() {
+  local target=$1 args=$2 gen=$3
+  [ -f "$work/$gen.in" ] || $gen > "$work/$gen.in"
+  echo "pgo-train: $target $args < $gen"
+  "$bin/$target" $args < "$work/$gen.in" > /dev/null
+}
+
+for w in "${LAB_WORKLOADS[@]}"; do
+  IFS='|' read -r target src args gen <<< "$w"
+  run "$target" "$args" "$gen"
+done
+for w in "${LAB_TRAINING_EXTRA[@]}"; do
+  IFS='|' read -r target args gen <<< "$w"
+  run "$target" "$args" "$gen"
+done
+echo "pgo-train: bench --quick"
+"$bin/bench" --quick --max-reps 3 --min-time 0 --out "$work/bench.json" 2> /dev/null
+
+# Clang пишет сырые профили, компилятору нужен один слитый
+if [[ "${CXX_COMPILER_ID:-}" == *Clang* ]]; then
+  dir=${LAB_PGO_DIR:?}
+  llvm-profdata merge -o "$dir/merged.profdata" "$dir"/*.profraw
+fi
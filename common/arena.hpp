@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string_view>
+#include <utility>
+
+// Память для структур из множества мелких объектов: узлы бора и суффиксного
+// дерева, строки токенов, списки смежности. Всё построено на std::pmr, так что
+// структуры принимают std::pmr::memory_resource* и работают с любым ресурсом.
+//
+// arena::Arena — монотонная арена: выдаёт память подряд из растущих блоков,
+// по одному ничего не освобождает и возвращает всё разом в release() или в
+// деструкторе. Структура, построенная в арене, при разрушении себя не обходит
+// (O(1) вместо обхода всех узлов). Арена должна пережить структуры в ней;
+// потокобезопасности нет.
+//
+// arena::CountingResource — прослойка-счётчик над любым ресурсом: число
+// выделений, байты, пик живой памяти. Ею арена считает свои блоки, её же
+// можно поставить перед пулом или кучей, чтобы узнать, сколько просит структура.
+namespace arena {
+
+struct Stats {
+    std::size_t allocs = 0;
+    std::size_t deallocs = 0;
+    std::size_t bytes = 0; // всего выдано
+    std::size_t live = 0;  // выдано и не возвращено
+    std::size_t peak = 0;
+
+    void onAllocate(std::size_t n) {
+        ++allocs;
+        bytes += n;
+        live += n;
+        if (live > peak) peak = live;
+    }
+
+    void onDeallocate(std::size_t n) {
+        ++deallocs;
+        live -= n;
+    }
+};
+
+class CountingResource : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource* upstream;
+    Stats st;
+
+    void* do_allocate(std::size_t n, std::size_t align) override {
+        void* p = upstream->allocate(n, align);
+        st.onAllocate(n);
+        return p;
+    }
+
+    void do_deallocate(void* p, std::size_t n, std::size_t align) override {
+        upstream->deallocate(p, n, align);
+        st.onDeallocate(n);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+public:
+    explicit CountingResource(std::pmr::memory_resource* up = std::pmr::new_delete_resource()) : upstream(up) {}
+
+    const Stats& stats() const { return st; }
+};
+
+class Arena : public std::pmr::memory_resource {
+private:
+    CountingResource blocks; // блоки от upstream; объявлен раньше mono и переживает его
+    std::pmr::monotonic_buffer_resource mono;
+    Stats st;                // запросы к самой арене
+
+    void* do_allocate(std::size_t n, std::size_t align) override {
+        void* p = mono.allocate(n, align);
+        st.onAllocate(n);
+        return p;
+    }
+
+    // память вернётся только вместе со всей ареной
+    void do_deallocate(void*, std::size_t n, std::size_t) override { st.onDeallocate(n); }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+public:
+    explicit Arena(std::size_t firstBlock = 64 << 10,
+                   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : blocks(upstream), mono(firstBlock, &blocks) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Всё, что было выдано, становится недействительным.
+    void release() {
+        mono.release();
+        st.live = 0;
+    }
+
+    const Stats& stats() const { return st; }
+    const Stats& blockStats() const { return blocks.stats(); }
+
+    template <class T, class... Args>
+    T* make(Args&&... args) {
+        return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // копия строки, живущая вместе с ареной
+    std::string_view copy(std::string_view s) {
+        if (s.empty()) return {};
+        char* p = static_cast<char*>(allocate(s.size(), 1));
+        std::memcpy(p, s.data(), s.size());
+        return {p, s.size()};
+    }
+};
+
+// Заканчивает жизнь obj без деструктора и ставит на его место пустой T, так что
+// обычный деструктор владельца ничего не обходит. Только для объектов, вся
+// память которых в арене, — иначе это утечка.
+template <class T>
+void abandon(T& obj) {
+    ::new (static_cast<void*>(std::addressof(obj))) T();
+}
+
+} // namespace arena
@@ -0,0 +1,39 @@
+#!/usr/bin/env bash
+# Сквозная пропускная способность каждой программы до и после перехода на
+# common/fastio.hpp. «До» — исходники из ревизии BASE (по умолчанию коммит
+# перед появлением fastio.hpp), «после» — рабочее дерево. Входы генерируются
+# с фиксированным seed, ответы обеих версий сравниваются побайтно.
+#
+#   common/bench_io.sh [BASE] [RUNS]
+set -euo pipefail
+
+root=$(cd "$(dirname "$0")/.." && pwd)
+cd "$root"
+base=${1:-$(git log --diff-filter=A --format=%H -- common/fastio.hpp | tail -1)^}
+runs=${2:-3}
+cxx=${CXX:-g++}
+flags="-O2 -std=c++17 -pthread"
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+mkdir -p "$work/before" "$work/after" "$work/bin"
+git archive "$base" lab1 lab2-3 lab4 lab5 lab6 lab7 lab8 | tar -x -C "$work/before"
+cp -r lab1 lab2-3 lab4 lab5 lab6 lab7 lab8 common "$work/after"
+
+source "$root/common/workloads.sh"
+
+printf '%-10s %9s %11s %10s %12s %11s %8s\n' binary input_mb before_ms after_ms before_mb_s after_mb_s speedup
+for b in "${LAB_WORKLOADS[@]}"; do
+  IFS='|' read -r id src args gen <<< "$b"
+  for side in before after; do
+    (cd "$work/$side" && $cxx $flags -o "$work/bin/$id.$side" "$src")
+  done
+  input="$work/$id.in"
+  $gen > "$input"
+  (cd "$work" && before=$(time_ms "$work/bin/$id.before" "$args" "$input" "$work/$id.before.out" "$runs")
+   after=$(time_ms "$work/bin/$id.after" "$args" "$input" "$work/$id.after.out" "$runs")
+   cmp -s "$work/$id.before.out" "$work/$id.after.out" || { echo "$id: outputs differ" >&2; exit 1; }
+   awk -v n="$id" -v sz="$(stat -c %s "$input")" -v b="$before" -v a="$after" 'BEGIN {
+     mb = sz / 1048576; if (b < 1) b = 1; if (a < 1) a = 1
+     printf "%-10s %9.1f %11d %10d %12.1f %11.1f %7.2fx\n", n, mb, b, a, mb * 1000 / b, mb * 1000 / a, b / a }')
+done
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Общий быстрый ввод-вывод для всех лабораторных вместо std::cin / std::cout.
+//
+// FastReader читает с дескриптора: обычный файл отображается в память целиком,
+// канал или терминал читается блоками. Пробелы — те же, что у isspace в
+// локали "C", поэтому токены и числа разбираются так же, как operator>>.
+// FastWriter копит вывод в большом буфере и сам форматирует целые.
+
+class FastWriter {
+private:
+    int fd;
+    std::vector<char> buf;
+    std::size_t len;
+
+    static const char* digitPairs() {
+        static const char pairs[201] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        return pairs;
+    }
+
+    // цифры x справа налево, по две за шаг; возвращает начало записи
+    static char* formatDigits(unsigned long long x, char* end) {
+        const char* pairs = digitPairs();
+        while (x >= 100) {
+            unsigned d = static_cast<unsigned>(x % 100) * 2;
+            x /= 100;
+            *--end = pairs[d + 1];
+            *--end = pairs[d];
+        }
+        if (x >= 10) {
+            unsigned d = static_cast<unsigned>(x) * 2;
+            *--end = pairs[d + 1];
+            *--end = pairs[d];
+        } else {
+            *--end = static_cast<char>('0' + x);
+        }
+        return end;
+    }
+
+    void writeRaw(const char* s, std::size_t n) {
+        while (n > 0) {
+            ssize_t w = ::write(fd, s, n);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                return;
+            }
+            s += w;
+            n -= static_cast<std::size_t>(w);
+        }
+    }
+
+public:
+    explicit FastWriter(int f = 1, std::size_t cap = 1 << 20) : fd(f), buf(cap), len(0) {}
+
+    FastWriter(const FastWriter&) = delete;
+    FastWriter& operator=(const FastWriter&) = delete;
+
+    void flush() {
+        writeRaw(buf.data(), len);
+        len = 0;
+    }
+
+    void put(char c) {
+        if (len == buf.size()) flush();
+        buf[len++] = c;
+    }
+
+    void write(const char* s, std::size_t n) {
+        if (len + n > buf.size()) {
+            flush();
+            // больше буфера — пишем напрямую
+            if (n > buf.size()) {
+                writeRaw(s, n);
+                return;
+            }
+        }
+        std::memcpy(buf.data() + len, s, n);
+        len += n;
+    }
+
+    void write(std::string_view s) { write(s.data(), s.size()); }
+
+    template <class T>
+    void writeInt(T x) {
+        static_assert(std::is_integral<T>::value, "writeInt needs an integer");
+        if (len + 24 > buf.size()) flush();
+        char tmp[24];
+        char* end = tmp + sizeof(tmp);
+        char* b;
+        if constexpr (std::is_signed<T>::value) {
+            unsigned long long u = x < 0 ? 0ULL - static_cast<unsigned long long>(x)
+                                         : static_cast<unsigned long long>(x);
+            b = formatDigits(u, end);
+            if (x < 0) *--b = '-';
+        } else {
+            b = formatDigits(x, end);
+        }
+        std::memcpy(buf.data() + len, b, end - b);
+        len += end - b;
+    }
+
+    // неотрицательное число, дополненное слева нулями до width знаков
+    void writeUIntPadded(unsigned long long x, int width) {
+        if (len + 24 + static_cast<std::size_t>(width) > buf.size()) flush();
+        char tmp[24];
+        char* end = tmp + sizeof(tmp);
+        char* b = formatDigits(x, end);
+        for (int pad = width - static_cast<int>(end - b); pad > 0; --pad) buf[len++] = '0';
+        std::memcpy(buf.data() + len, b, end - b);
+        len += end - b;
+    }
+
+    ~FastWriter() { flush(); }
+};
+
+class FastReader {
+private:
+    static constexpr std::size_t BLOCK = 1 << 16;
+
+    int fd;
+    const char* p;
+    const char* end;
+    std::vector<char> buf;
+    void* mapped;
+    std::size_t mappedLen;
+    bool done;
+    FastWriter* tied;
+
+    // Дочитывает блок, сохраняя непрочитанный хвост. false — ввод кончился.
+    bool refill() {
+        if (done) return false;
+        std::size_t tail = static_cast<std::size_t>(end - p);
+        std::size_t from = tail ? static_cast<std::size_t>(p - buf.data()) : 0;
+        if (buf.size() < tail + BLOCK) buf.resize(tail + BLOCK);
+        std::memmove(buf.data(), buf.data() + from, tail);
+        // перед тем как ждать ввода, отдаём накопленный ответ — так работает
+        // и интерактивный обмен, как с cin.tie(&cout)
+        if (tied) tied->flush();
+        ssize_t r;
+        do {
+            r = ::read(fd, buf.data() + tail, BLOCK);
+        } while (r < 0 && errno == EINTR);
+        p = buf.data();
+        end = p + tail;
+        if (r <= 0) {
+            done = true;
+            return false;
+        }
+        end += r;
+        return true;
+    }
+
+public:
+    // Пробел в смысле isspace в локали "C", без ветвлений по видам символов.
+    static bool isSpace(char c) {
+        unsigned u = static_cast<unsigned char>(c);
+        return (u == ' ') | (u - '\t' < 5u); // ' ', \t \n \v \f \r
+    }
+
+    explicit FastReader(int f = 0)
+        : fd(f), p(nullptr), end(nullptr), mapped(nullptr), mappedLen(0), done(false), tied(nullptr) {
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) return;
+        off_t from = ::lseek(fd, 0, SEEK_CUR);
+        if (from < 0 || from >= st.st_size) return;
+        void* base = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED) return;
+        ::madvise(base, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+        mapped = base;
+        mappedLen = static_cast<std::size_t>(st.st_size);
+        p = static_cast<const char*>(base) + from;
+        end = static_cast<const char*>(base) + mappedLen;
+        done = true;
+    }
+
+    // Чтение из готового буфера в памяти (тесты, бенчмарки).
+    FastReader(const char* data, std::size_t n)
+        : fd(-1), p(data), end(data + n), mapped(nullptr), mappedLen(0), done(true), tied(nullptr) {}
+
+    FastReader(const FastReader&) = delete;
+    FastReader& operator=(const FastReader&) = delete;
+
+    ~FastReader() {
+        if (mapped) ::munmap(mapped, mappedLen);
+    }
+
+    // writer сбрасывается перед каждым ожиданием ввода
+    void tie(FastWriter* w) { tied = w; }
+
+    // false, если до конца ввода остались одни пробелы
+    bool skipSpace() {
+        for (;;) {
+            while (p != end && isSpace(*p)) ++p;
+            if (p != end) return true;
+            if (!refill()) return false;
+        }
+    }
+
+    // следующий непробельный символ, -1 в конце ввода
+    int readChar() {
+        if (!skipSpace()) return -1;
+        return static_cast<unsigned char>(*p++);
+    }
+
+    // Целое со знаком или без, как operator>>: false, если дальше не число
+    // (тогда ввод не сдвигается дальше пробелов и знака).
+    template <class T>
+    bool readInt(T& out) {
+        static_assert(std::is_integral<T>::value, "readInt needs an integer");
+        using U = typename std::make_unsigned<T>::type;
+        if (!skipSpace()) return false;
+        bool neg = (*p == '-');
+        if (neg || *p == '+') {
+            ++p;
+            if (p == end && !refill()) return false;
+        }
+        if (static_cast<unsigned>(*p - '0') > 9) return false;
+        U x = 0;
+        // число может перейти через границу блока — тогда дочитываем и продолжаем
+        for (;;) {
+            unsigned d;
+            while (p != end && (d = static_cast<unsigned>(*p - '0')) <= 9) {
+                x = static_cast<U>(x * 10 + d);
+                ++p;
+            }
+            if (p != end || !refill()) break;
+        }
+        out = static_cast<T>(neg ? static_cast<U>(0 - x) : x);
+        return true;
+    }
+
+    // слово до пробела
+    bool readToken(std::string& s) {
+        s.clear();
+        if (!skipSpace()) return false;
+        for (;;) {
+            const char* b = p;
+            while (p != end && !isSpace(*p)) ++p;
+            s.append(b, p);
+            if (p != end || !refill()) return true;
+        }
+    }
+
+    // Строка до '\n' без него, как std::getline: false только в конце ввода.
+    bool readLine(std::string& s) {
+        s.clear();
+        if (p == end && !refill()) return false;
+        for (;;) {
+            const void* nl = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+            if (nl) {
+                const char* e = static_cast<const char*>(nl);
+                s.append(p, e);
+                p = e + 1;
+                return true;
+            }
+            s.append(p, end);
+            p = end;
+            if (!refill()) return true;
+        }
+    }
+};
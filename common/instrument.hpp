@@ -0,0 +1,245 @@
+#pragma once
+
+// Инструментирование горячих путей. Включается только при компиляции:
+// -DLAB_INSTRUMENT (cmake -DLAB_INSTRUMENT=ON), без него все макросы пустые.
+//
+//   LAB_PHASE("build");        — фаза до конца области видимости;
+//   LAB_COUNT("lab5.split");   — событие +1;
+//   LAB_COUNT_ADD("name", n);  — событие +n.
+//
+// Фазы вкладываются: время внутренней фазы не входит во внешнюю, поэтому
+// внешняя "parse" на всю main получает всё, что не попало в build, query и
+// output. При выходе из программы в stderr печатается отчёт по фазам и
+// счётчикам. С -DLAB_INSTRUMENT_PERF к времени добавляются такты, промахи
+// кэша и ошибки предсказания переходов из perf_event_open (только
+// пользовательский режим; если ядро не разрешает, отчёт скажет об этом).
+// Каждый вход и выход фазы с perf — это чтение группы счётчиков системным
+// вызовом (порядка микросекунды), поэтому в программах с фазой на каждую
+// команду (lab2-3) время в отчёте завышено; без perf остаётся только clock.
+// Фазы ведёт главный поток, счётчики можно трогать из любого.
+
+#ifdef LAB_INSTRUMENT
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <string>
+
+#ifdef LAB_INSTRUMENT_PERF
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace instr {
+
+constexpr int HW = 3; // такты, промахи кэша, ошибки предсказания
+
+struct Sample {
+    std::uint64_t ns = 0;
+    std::uint64_t hw[HW] = {0, 0, 0};
+};
+
+struct Phase {
+    std::string name;
+    std::uint64_t calls = 0;
+    Sample self; // без вложенных фаз
+};
+
+struct Counter {
+    std::string name;
+    std::atomic<std::uint64_t> value{0};
+};
+
+class Registry {
+private:
+    std::deque<Phase> phases;     // deque: адреса не меняются, на них ссылаются места вызова
+    std::deque<Counter> counters;
+    int perfFd[HW] = {-1, -1, -1};
+    const char* perfError = "not compiled in (-DLAB_INSTRUMENT_PERF)";
+
+#ifdef LAB_INSTRUMENT_PERF
+    void openPerf() {
+        static const std::uint64_t configs[HW] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES,
+                                                  PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < HW; ++i) {
+            perf_event_attr a;
+            std::memset(&a, 0, sizeof(a));
+            a.type = PERF_TYPE_HARDWARE;
+            a.size = sizeof(a);
+            a.config = configs[i];
+            a.exclude_kernel = 1;
+            a.exclude_hv = 1;
+            a.read_format = PERF_FORMAT_GROUP;
+            // все три в одной группе: одно чтение на замер
+            long fd = ::syscall(SYS_perf_event_open, &a, 0, -1, i == 0 ? -1 : perfFd[0], 0);
+            if (fd < 0) {
+                perfError = std::strerror(errno);
+                closePerf();
+                return;
+            }
+            perfFd[i] = static_cast<int>(fd);
+        }
+        perfError = nullptr;
+    }
+#endif
+
+    void closePerf() {
+        for (int& fd : perfFd) {
+#ifdef LAB_INSTRUMENT_PERF
+            if (fd >= 0) ::close(fd);
+#endif
+            fd = -1;
+        }
+    }
+
+    Registry() {
+#ifdef LAB_INSTRUMENT_PERF
+        openPerf();
+#endif
+    }
+
+    static double ms(std::uint64_t ns) { return static_cast<double>(ns) / 1e6; }
+
+    void report() const {
+        if (phases.empty() && counters.empty()) return;
+        std::fprintf(stderr, "== instrumentation ==\n");
+        if (!phases.empty()) {
+            std::fprintf(stderr, "%-10s %10s %12s", "phase", "calls", "ms");
+            if (!perfError) std::fprintf(stderr, " %16s %14s %14s", "cycles", "cache-misses", "branch-misses");
+            std::fprintf(stderr, "\n");
+            Sample total;
+            for (const Phase& p : phases) {
+                std::fprintf(stderr, "%-10s %10llu %12.3f", p.name.c_str(),
+                             static_cast<unsigned long long>(p.calls), ms(p.self.ns));
+                if (!perfError)
+                    std::fprintf(stderr, " %16llu %14llu %14llu", static_cast<unsigned long long>(p.self.hw[0]),
+                                 static_cast<unsigned long long>(p.self.hw[1]),
+                                 static_cast<unsigned long long>(p.self.hw[2]));
+                std::fprintf(stderr, "\n");
+                total.ns += p.self.ns;
+                for (int i = 0; i < HW; ++i) total.hw[i] += p.self.hw[i];
+            }
+            std::fprintf(stderr, "%-10s %10s %12.3f", "total", "", ms(total.ns));
+            if (!perfError)
+                std::fprintf(stderr, " %16llu %14llu %14llu", static_cast<unsigned long long>(total.hw[0]),
+                             static_cast<unsigned long long>(total.hw[1]),
+                             static_cast<unsigned long long>(total.hw[2]));
+            std::fprintf(stderr, "\n");
+            if (perfError) std::fprintf(stderr, "hardware counters unavailable: %s\n", perfError);
+        }
+        for (const Counter& c : counters)
+            std::fprintf(stderr, "%-28s %16llu\n", c.name.c_str(),
+                         static_cast<unsigned long long>(c.value.load(std::memory_order_relaxed)));
+    }
+
+public:
+    Phase* current = nullptr; // самая внутренняя открытая фаза
+    Sample resumed;           // когда current в последний раз продолжила считать
+
+    static Registry& get() {
+        static Registry r;
+        return r;
+    }
+
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    ~Registry() {
+        report();
+        closePerf();
+    }
+
+    Phase& phase(const char* name) {
+        for (Phase& p : phases)
+            if (p.name == name) return p;
+        phases.emplace_back();
+        phases.back().name = name;
+        return phases.back();
+    }
+
+    Counter& counter(const char* name) {
+        for (Counter& c : counters)
+            if (c.name == name) return c;
+        counters.emplace_back();
+        counters.back().name = name;
+        return counters.back();
+    }
+
+    Sample now() const {
+        Sample s;
+        s.ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now().time_since_epoch())
+                                              .count());
+#ifdef LAB_INSTRUMENT_PERF
+        if (!perfError) {
+            std::uint64_t buf[1 + HW];
+            if (::read(perfFd[0], buf, sizeof(buf)) == static_cast<ssize_t>(sizeof(buf)))
+                for (int i = 0; i < HW; ++i) s.hw[i] = buf[1 + i];
+        }
+#endif
+        return s;
+    }
+
+    // отдаёт current всё, что накопилось с resumed
+    void charge(const Sample& t) {
+        if (!current) return;
+        current->self.ns += t.ns - resumed.ns;
+        for (int i = 0; i < HW; ++i) current->self.hw[i] += t.hw[i] - resumed.hw[i];
+    }
+};
+
+class ScopedPhase {
+private:
+    Phase* parent;
+
+public:
+    explicit ScopedPhase(Phase& p) {
+        Registry& r = Registry::get();
+        Sample t = r.now();
+        r.charge(t);
+        parent = r.current;
+        r.current = &p;
+        r.resumed = t;
+        ++p.calls;
+    }
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+    ~ScopedPhase() {
+        Registry& r = Registry::get();
+        Sample t = r.now();
+        r.charge(t);
+        r.current = parent;
+        r.resumed = t;
+    }
+};
+
+} // namespace instr
+
+#define LAB_INSTR_CAT2(a, b) a##b
+#define LAB_INSTR_CAT(a, b) LAB_INSTR_CAT2(a, b)
+
+#define LAB_PHASE(name)                                                                         \
+    static ::instr::Phase& LAB_INSTR_CAT(labPhase_, __LINE__) = ::instr::Registry::get().phase(name); \
+    ::instr::ScopedPhase LAB_INSTR_CAT(labScope_, __LINE__)(LAB_INSTR_CAT(labPhase_, __LINE__))
+
+#define LAB_COUNT_ADD(name, n)                                                                   \
+    do {                                                                                         \
+        static ::instr::Counter& labCounter_ = ::instr::Registry::get().counter(name);           \
+        labCounter_.value.fetch_add(static_cast<std::uint64_t>(n), std::memory_order_relaxed);   \
+    } while (0)
+
+#else
+
+#define LAB_PHASE(name) static_cast<void>(0)
+#define LAB_COUNT_ADD(name, n) static_cast<void>(0)
+
+#endif
+
+#define LAB_COUNT(name) LAB_COUNT_ADD(name, 1)
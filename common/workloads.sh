@@ -0,0 +1,94 @@
+# Общие входы для сквозных замеров (common/bench_io.sh, cmake/compare_configs.sh)
+# и для обучения PGO (cmake/pgo_train.sh). Подключается через source.
+# Генераторы детерминированы: awk с фиксированным srand.
+
+# цель CMake|исходник|аргументы|генератор — основной замер каждой программы
+LAB_WORKLOADS=(
+  "lab1|lab1/main.cpp||gen_lab1"
+  "lab2_3|lab2-3/TPatriciaTrie.cpp||gen_lab23"
+  "lab4|lab4/main.cpp||gen_lab4"
+  "lab5|lab5/main.cpp||gen_lab5"
+  "lab6|lab6/main.cpp|--serve|gen_lab6"
+  "lab7_var2|lab7/var2/main.cpp||gen_lab7_var2"
+  "lab7_var4|lab7/var4/main.cpp||gen_lab7_var4"
+  "lab8|lab8/main.cpp|--hk|gen_lab8"
+)
+
+# остальные режимы, которые прогоняются при обучении PGO: цель|аргументы|генератор
+LAB_TRAINING_EXTRA=(
+  "lab5|--suffix-array 1|gen_lab5"
+  "lab6||gen_lab6_single"
+  "lab6|--packed|gen_lab6_single"
+  "lab7_var2|--fast|gen_lab7_var2"
+  "lab8||gen_lab8_small"
+  "lab8|--epoch --warm|gen_lab8"
+  "lab8|--assign|gen_lab8_small"
+)
+
+gen_lab1() {
+  awk 'BEGIN { srand(1); for (i = 0; i < 2000000; ++i) {
+    v = ""; k = 1 + int(rand() * 24); for (j = 0; j < k; ++j) v = v sprintf("%c", 97 + int(rand() * 26))
+    printf "%06d\t%s\n", int(rand() * 1000000), v } }'
+}
+
+gen_lab23() {
+  awk 'BEGIN { srand(2); for (i = 0; i < 1000000; ++i) {
+    w = ""; k = 1 + int(rand() * 12); for (j = 0; j < k; ++j) w = w sprintf("%c", 97 + int(rand() * 6))
+    r = rand()
+    if (r < 0.4) printf "+ %s %d\n", w, int(rand() * 1000000000)
+    else if (r < 0.6) printf "- %s\n", w
+    else print w } }'
+}
+
+gen_lab4() {
+  awk 'BEGIN { srand(3); print "ab ba ab"; for (i = 0; i < 1000000; ++i) {
+    k = int(rand() * 12); s = ""
+    for (j = 0; j < k; ++j) s = s (j ? " " : "") (rand() < 0.5 ? "ab" : "BA")
+    print s } }'
+}
+
+gen_lab5() {
+  awk 'BEGIN { srand(4); for (t = 0; t < 2; ++t) {
+    s = ""; for (i = 0; i < 1000000; ++i) s = s (rand() < 0.5 ? "a" : "b"); print s } }'
+}
+
+gen_lab6() {
+  awk 'BEGIN { srand(5); for (i = 0; i < 300000; ++i) print 1 + int(rand() * 3000) }'
+}
+
+gen_lab6_single() {
+  echo 30000000
+}
+
+gen_lab7_var2() {
+  awk 'BEGIN { srand(6); n = 2000000; print n
+    for (i = 0; i < n; ++i) { l = int(rand() * 1000000) - 1000; print l, l + int(rand() * 3000) }
+    print 1000000 }'
+}
+
+gen_lab7_var4() {
+  awk 'BEGIN { srand(7); m = 40000; n = 50; print m, n
+    for (i = 0; i < m; ++i) { s = ""; for (j = 0; j < n; ++j) s = s int(rand() * 50) " "; print s int(1 + rand() * 100) } }'
+}
+
+gen_lab8() {
+  awk 'BEGIN { srand(8); n = 400000; m = 2000000; print n, m
+    for (i = 0; i < m; ++i) print 1 + int(rand() * n / 2), n / 2 + 1 + int(rand() * n / 2) }'
+}
+
+# Кун без ускорений и назначение медленнее, им хватает графа поменьше
+gen_lab8_small() {
+  awk 'BEGIN { srand(9); n = 20000; m = 60000; print n, m
+    for (i = 0; i < m; ++i) print 1 + int(rand() * n / 2), n / 2 + 1 + int(rand() * n / 2) }'
+}
+
+# медиана времени запуска в миллисекундах: time_ms BIN "ARGS" INPUT OUTPUT RUNS
+time_ms() {
+  local bin=$1 args=$2 input=$3 out=$4 runs=$5 t=()
+  for ((r = 0; r < runs; ++r)); do
+    local s=$(date +%s%N)
+    "$bin" $args < "$input" > "$out"
+    t+=($(( ($(date +%s%N) - s) / 1000000 )))
+  done
+  printf '%s\n' "${t[@]}" | sort -n | sed -n "$(( (runs + 1) / 2 ))p"
+}
@@ -0,0 +1,200 @@
+// Точка входа фаззеров без libFuzzer.
+//
+//   fuzz_lab5 FILE...              — прогон сохранённых входов (воспроизведение, корпус);
+//   fuzz_lab5 < FILE               — один вход со stdin (afl-fuzz ... -- fuzz_lab5);
+//   fuzz_lab5 --runs N [--seed S] [--max-len L]
+//                                  — N случайных входов длиной до L байт.
+//   --out FILE                     — записать время прогона в FILE как базу для
+//                                    следующих прогонов: по строке JSON на цель,
+//                                    строки других целей сохраняются;
+//   --compare OLD.json [--threshold R] [--min-ms T]
+//                                  — код выхода 3, если кандидаты в сумме
+//                                    медленнее, чем в записанном --out прогоне
+//                                    этой же цели с теми же --runs, --seed и
+//                                    --max-len, больше чем в R раз (по умолчанию
+//                                    1.10); прогоны короче T мс (по умолчанию 50,
+//                                    ниже — шум таймера) не сравниваются;
+//   --crash FILE                   — куда сохранить вход, на котором нашлось
+//                                    расхождение (по умолчанию fuzz-crash.bin).
+//
+// Расхождение — abort() из FUZZ_CHECK с описанием в stderr.
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "fuzz.hpp"
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size);
+
+namespace {
+
+void runOne(const std::vector<std::uint8_t>& in) {
+    fuzz::Artifact& a = fuzz::artifact();
+    a.data = in.data();
+    a.size = in.size();
+    LLVMFuzzerTestOneInput(in.data(), in.size());
+    ++fuzz::timing().inputs;
+}
+
+std::vector<std::uint8_t> readAll(std::FILE* f) {
+    std::vector<std::uint8_t> buf;
+    std::uint8_t chunk[1 << 16];
+    for (std::size_t got; (got = std::fread(chunk, 1, sizeof(chunk), f)) > 0;)
+        buf.insert(buf.end(), chunk, chunk + got);
+    return buf;
+}
+
+// Параметры и время одного прогона цели, строка JSON в файле --out.
+struct Run {
+    std::string target;
+    long long runs = -1;
+    std::uint64_t seed = 0;
+    int maxLen = 0;
+    std::uint64_t inputs = 0;
+    double oracleMs = 0, candidateMs = 0;
+};
+
+void writeRun(std::FILE* f, const Run& r) {
+    std::fprintf(f,
+                 "{\"target\": \"%s\", \"runs\": %lld, \"seed\": %llu, \"max_len\": %d, \"inputs\": %llu, "
+                 "\"oracle_ms\": %.4f, \"candidate_ms\": %.4f}\n",
+                 r.target.c_str(), r.runs, static_cast<unsigned long long>(r.seed), r.maxLen,
+                 static_cast<unsigned long long>(r.inputs), r.oracleMs, r.candidateMs);
+}
+
+// Прогон цели target из файла, записанного --out; false, если его там нет.
+bool readRun(const std::string& path, const std::string& target, Run& r) {
+    std::ifstream in(path);
+    std::string line;
+    auto field = [&](const char* key) -> std::string {
+        std::size_t p = line.find(key);
+        if (p == std::string::npos) return "";
+        p += std::strlen(key);
+        std::size_t e = line.find_first_of(",}", p);
+        std::string v = line.substr(p, e - p);
+        if (v.size() >= 2 && v.front() == '"') v = v.substr(1, v.size() - 2);
+        return v;
+    };
+    while (std::getline(in, line)) {
+        if (field("\"target\": ") != target) continue;
+        r.target = target;
+        r.runs = std::atoll(field("\"runs\": ").c_str());
+        r.seed = std::strtoull(field("\"seed\": ").c_str(), nullptr, 10);
+        r.maxLen = std::atoi(field("\"max_len\": ").c_str());
+        r.inputs = std::strtoull(field("\"inputs\": ").c_str(), nullptr, 10);
+        r.oracleMs = std::atof(field("\"oracle_ms\": ").c_str());
+        r.candidateMs = std::atof(field("\"candidate_ms\": ").c_str());
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long long runs = -1;
+    std::uint64_t seed = 1;
+    int maxLen = 256;
+    double threshold = 1.10, minMs = 50;
+    std::string crash = "fuzz-crash.bin", out, compare;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool more = i + 1 < argc;
+        if (arg == "--runs" && more) runs = std::atoll(argv[++i]);
+        else if (arg == "--seed" && more) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--max-len" && more) maxLen = std::atoi(argv[++i]);
+        else if (arg == "--threshold" && more) threshold = std::atof(argv[++i]);
+        else if (arg == "--min-ms" && more) minMs = std::atof(argv[++i]);
+        else if (arg == "--crash" && more) crash = argv[++i];
+        else if (arg == "--out" && more) out = argv[++i];
+        else if (arg == "--compare" && more) compare = argv[++i];
+        else if (arg.rfind("--", 0) == 0) {
+            std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+            return 2;
+        } else files.push_back(arg);
+    }
+    fuzz::artifact().path = crash.c_str();
+
+    if (runs >= 0) {
+        std::mt19937_64 rng(seed);
+        std::vector<std::uint8_t> in;
+        for (long long r = 0; r < runs; ++r) {
+            in.resize(rng() % (static_cast<std::uint64_t>(maxLen) + 1));
+            for (auto& b : in) b = static_cast<std::uint8_t>(rng());
+            runOne(in);
+        }
+    }
+    for (const std::string& path : files) {
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) {
+            std::fprintf(stderr, "cannot open %s\n", path.c_str());
+            return 2;
+        }
+        runOne(readAll(f));
+        std::fclose(f);
+    }
+    if (runs < 0 && files.empty()) {
+        fuzz::artifact().path = nullptr; // вход и так у вызывающего
+        runOne(readAll(stdin));
+    }
+
+    const fuzz::Timing& t = fuzz::timing();
+    Run cur;
+    const char* slash = std::strrchr(argv[0], '/');
+    cur.target = slash ? slash + 1 : argv[0];
+    cur.runs = runs;
+    cur.seed = seed;
+    cur.maxLen = maxLen;
+    cur.inputs = t.inputs;
+    cur.oracleMs = t.oracleNs / 1e6;
+    cur.candidateMs = t.candidateNs / 1e6;
+    std::fprintf(stderr, "%llu inputs ok, oracle %.3f ms, candidate %.3f ms\n",
+                 static_cast<unsigned long long>(t.inputs), cur.oracleMs, cur.candidateMs);
+
+    if (!out.empty()) {
+        // строки других целей остаются, строка этой заменяется
+        std::vector<std::string> keep;
+        {
+            std::ifstream in(out);
+            std::string key = "\"target\": \"" + cur.target + "\"", line;
+            while (std::getline(in, line))
+                if (!line.empty() && line.find(key) == std::string::npos) keep.push_back(line);
+        }
+        std::FILE* f = std::fopen(out.c_str(), "w");
+        if (!f) {
+            std::fprintf(stderr, "cannot write %s\n", out.c_str());
+            return 2;
+        }
+        for (const std::string& line : keep) std::fprintf(f, "%s\n", line.c_str());
+        writeRun(f, cur);
+        std::fclose(f);
+    }
+    if (!compare.empty()) {
+        Run old;
+        if (!readRun(compare, cur.target, old)) {
+            std::fprintf(stderr, "no baseline for %s in %s\n", cur.target.c_str(), compare.c_str());
+            return 2;
+        }
+        // на других входах время несравнимо
+        if (old.runs != cur.runs || old.seed != cur.seed || old.maxLen != cur.maxLen || old.inputs != cur.inputs) {
+            std::fprintf(stderr, "baseline in %s was recorded with other --runs/--seed/--max-len or inputs\n",
+                         compare.c_str());
+            return 2;
+        }
+        double ratio = old.candidateMs > 0 ? cur.candidateMs / old.candidateMs : 0;
+        std::fprintf(stderr, "candidate %.3f ms, baseline %.3f ms, ratio %.2fx\n", cur.candidateMs, old.candidateMs,
+                     ratio);
+        if (old.candidateMs >= minMs && cur.candidateMs >= minMs && ratio > threshold) {
+            std::fprintf(stderr, "performance regression: %.2fx > %.2fx\n", ratio, threshold);
+            return 3;
+        }
+    }
+    return 0;
+}
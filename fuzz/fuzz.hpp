@@ -0,0 +1,170 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+
+// Дифференциальные фаззеры: каждый fuzz/<лаба>.cpp определяет
+// LLVMFuzzerTestOneInput, который разбирает байты входа в задачу, решает её
+// эталоном (простая исходная реализация) и оптимизированными движками из
+// каталога лабораторной и падает через abort() на первом расхождении. Так
+// цели подходят и libFuzzer (-DLAB_FUZZ_ENGINE=libfuzzer), и AFL (driver.cpp
+// читает вход из файла или stdin), и обычному прогону на случайных байтах
+// (driver.cpp --runs).
+//
+// Время эталона и кандидата копится в fuzz::timing() через fuzz::oracle() и
+// fuzz::candidate(); driver.cpp печатает итог, записывает время кандидатов в
+// базу (--out) и сообщает о регрессии относительно неё (--compare).
+namespace fuzz {
+
+// Читает значения из байтов входа, как FuzzedDataProvider. Когда байты
+// кончаются, все значения нулевые: любой вход — корректная задача.
+class Input {
+private:
+    const std::uint8_t* p;
+    std::size_t n;
+
+public:
+    Input(const std::uint8_t* data, std::size_t size) : p(data), n(size) {}
+
+    bool empty() const { return n == 0; }
+    std::size_t remaining() const { return n; }
+
+    std::uint32_t u32() {
+        std::uint32_t x = 0;
+        for (int i = 0; i < 4 && n > 0; ++i, ++p, --n) x |= static_cast<std::uint32_t>(*p) << (8 * i);
+        return x;
+    }
+
+    std::uint8_t byte() {
+        if (n == 0) return 0;
+        --n;
+        return *p++;
+    }
+
+    bool flag() { return byte() & 1; }
+
+    // [lo, hi]; до 256 значений — один байт
+    int range(int lo, int hi) {
+        std::uint64_t span = static_cast<std::uint64_t>(static_cast<std::int64_t>(hi) - lo) + 1;
+        std::uint64_t x = span <= 256 ? byte() : u32();
+        return static_cast<int>(lo + static_cast<std::int64_t>(x % span));
+    }
+
+    // строка длины [minLen, maxLen] из символов alphabet
+    std::string str(std::string_view alphabet, int minLen, int maxLen) {
+        std::string s(static_cast<std::size_t>(range(minLen, maxLen)), alphabet[0]);
+        for (char& c : s) c = alphabet[range(0, static_cast<int>(alphabet.size()) - 1)];
+        return s;
+    }
+};
+
+struct Timing {
+    std::uint64_t oracleNs = 0;
+    std::uint64_t candidateNs = 0;
+    std::uint64_t inputs = 0;
+};
+
+inline Timing& timing() {
+    static Timing t;
+    return t;
+}
+
+inline std::uint64_t nowNs() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+template <class F>
+auto timed(std::uint64_t& acc, F&& f) {
+    struct Stop {
+        std::uint64_t& acc;
+        std::uint64_t start;
+        ~Stop() { acc += nowNs() - start; }
+    } stop{acc, nowNs()};
+    return f();
+}
+
+template <class F>
+auto oracle(F&& f) {
+    return timed(timing().oracleNs, f);
+}
+
+template <class F>
+auto candidate(F&& f) {
+    return timed(timing().candidateNs, f);
+}
+
+// Временный файл для движков с индексом на диске; удаляется в деструкторе.
+// По умолчанию в /dev/shm: на ext4 перезапись и удаление тысяч файлов в /tmp
+// упираются в сброс на диск и замедляют прогон на порядки.
+class TempFile {
+private:
+    std::string p;
+
+public:
+    TempFile() {
+        const char* dir = std::getenv("TMPDIR");
+        if (!dir || !*dir) dir = ::access("/dev/shm", W_OK) == 0 ? "/dev/shm" : "/tmp";
+        std::string tmpl = std::string(dir) + "/lab_fuzz_XXXXXX";
+        int fd = ::mkstemp(tmpl.data());
+        if (fd < 0) {
+            std::perror("mkstemp");
+            std::abort();
+        }
+        ::close(fd);
+        p = tmpl;
+    }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    ~TempFile() { ::unlink(p.c_str()); }
+
+    const std::string& path() const { return p; }
+};
+
+// Куда driver.cpp просит сохранить вход перед падением (libFuzzer и AFL
+// сохраняют его сами).
+struct Artifact {
+    const char* path = nullptr;
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+};
+
+inline Artifact& artifact() {
+    static Artifact a;
+    return a;
+}
+
+[[noreturn]] inline void fail(const char* file, int line, const char* what, const std::string& detail) {
+    std::fprintf(stderr, "%s:%d: mismatch: %s\n", file, line, what);
+    if (!detail.empty()) std::fprintf(stderr, "  %s\n", detail.c_str());
+    const Artifact& a = artifact();
+    if (a.path) {
+        if (std::FILE* f = std::fopen(a.path, "wb")) {
+            if (a.size) std::fwrite(a.data, 1, a.size, f);
+            std::fclose(f);
+            std::fprintf(stderr, "  input saved to %s\n", a.path);
+        }
+    }
+    std::abort();
+}
+
+} // namespace fuzz
+
+// FUZZ_CHECK(cond) или FUZZ_CHECK(cond, строка-пояснение); пояснение
+// строится только при расхождении.
+#define FUZZ_CHECK(...) FUZZ_CHECK_PICK(__VA_ARGS__, FUZZ_CHECK2, FUZZ_CHECK1, )(__VA_ARGS__)
+#define FUZZ_CHECK_PICK(a, b, macro, ...) macro
+#define FUZZ_CHECK1(cond) FUZZ_CHECK2(cond, std::string())
+#define FUZZ_CHECK2(cond, detail)                                       \
+    do {                                                                \
+        if (!(cond)) ::fuzz::fail(__FILE__, __LINE__, #cond, detail);   \
+    } while (0)
@@ -0,0 +1,31 @@
+// Сортировка подсчётом против std::stable_sort по ключу.
+#include <algorithm>
+#include <vector>
+
+#include "fuzz.hpp"
+#include "../lab1/counting_sort.hpp"
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    fuzz::Input in(data, size);
+    std::vector<Item> items;
+    while (!in.empty()) {
+        Item it;
+        // чаще мелкие ключи, чтобы были повторы и проверялась устойчивость
+        it.key = in.flag() ? static_cast<size_t>(in.range(0, 15)) : static_cast<size_t>(in.range(0, MAX_KEY - 1));
+        it.value = in.str("abc", 0, 3);
+        items.push_back(std::move(it));
+    }
+
+    std::vector<Item> expected = fuzz::oracle([&] {
+        std::vector<Item> v = items;
+        std::stable_sort(v.begin(), v.end(), [](const Item& a, const Item& b) { return a.key < b.key; });
+        return v;
+    });
+    std::vector<Item> got = fuzz::candidate([&] { return countingSort(items); });
+
+    FUZZ_CHECK(got.size() == expected.size());
+    for (std::size_t i = 0; i < got.size(); ++i)
+        FUZZ_CHECK(got[i].key == expected[i].key && got[i].value == expected[i].value,
+                   "position " + std::to_string(i));
+    return 0;
+}
@@ -0,0 +1,84 @@
+// TPatriciaTrie в куче, пуле и арене против std::map на одной
+// последовательности вставок, удалений и поисков.
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "fuzz.hpp"
+#include "../lab2-3/TPatriciaTrie.hpp"
+
+namespace {
+
+struct Op {
+    int kind; // 0 — вставка, 1 — удаление, 2 — поиск
+    std::string key;
+    std::uint64_t value;
+};
+
+// результат операции: 0/1 для вставки и удаления, значение + 1 или 0 для поиска
+std::vector<std::uint64_t> runTrie(TPatriciaTrie& t, const std::vector<Op>& ops) {
+    std::vector<std::uint64_t> res;
+    res.reserve(ops.size());
+    for (const Op& op : ops) {
+        if (op.kind == 0) {
+            res.push_back(t.Insert(op.key, op.value));
+        } else if (op.kind == 1) {
+            res.push_back(t.Erase(op.key));
+        } else {
+            auto* node = t.Find(op.key);
+            res.push_back(node ? node->value + 1 : 0);
+        }
+    }
+    return res;
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    fuzz::Input in(data, size);
+    std::vector<Op> ops;
+    while (!in.empty()) {
+        Op op;
+        op.kind = in.range(0, 2);
+        // ключи, отличающиеся в разных битах, и общие префиксы
+        op.key = in.str("ab\x7fz", 1, 6);
+        op.value = in.u32();
+        ops.push_back(std::move(op));
+    }
+
+    std::vector<std::uint64_t> expected = fuzz::oracle([&] {
+        std::map<std::string, std::uint64_t> m;
+        std::vector<std::uint64_t> res;
+        res.reserve(ops.size());
+        for (const Op& op : ops) {
+            if (op.kind == 0) {
+                res.push_back(m.emplace(op.key, op.value).second);
+            } else if (op.kind == 1) {
+                res.push_back(m.erase(op.key));
+            } else {
+                auto it = m.find(op.key);
+                res.push_back(it == m.end() ? 0 : it->second + 1);
+            }
+        }
+        return res;
+    });
+
+    std::vector<std::uint64_t> heap = fuzz::candidate([&] {
+        TPatriciaTrie t;
+        return runTrie(t, ops);
+    });
+    FUZZ_CHECK(heap == expected, "heap trie");
+
+    std::pmr::unsynchronized_pool_resource pool;
+    {
+        TPatriciaTrie t(&pool);
+        FUZZ_CHECK(runTrie(t, ops) == expected, "pool trie");
+    }
+    arena::Arena a;
+    {
+        TPatriciaTrie t(a);
+        FUZZ_CHECK(runTrie(t, ops) == expected, "arena trie");
+    }
+    return 0;
+}
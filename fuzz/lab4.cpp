@@ -0,0 +1,55 @@
+// Поиск образца Z-функцией против посимвольного сравнения в каждой позиции
+// текста. Семантика та же, что у программы: слова склеиваются через пробел и
+// образец ищется как подстрока, так что вхождение может начинаться и внутри
+// слова — тогда ответ указывает на это слово.
+#include <string>
+#include <vector>
+
+#include "fuzz.hpp"
+#include "../lab4/search.hpp"
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    fuzz::Input in(data, size);
+    std::vector<std::string> pattern(in.range(1, 3));
+    for (auto& w : pattern) w = in.str("ab", 1, 2);
+
+    // слова короткие, чтобы вхождения были часты; строка может быть пустой
+    std::vector<std::string> words;
+    std::vector<TToken> tokens;
+    std::vector<int> lineOf, idxOf;
+    for (int line = 1; !in.empty(); ++line) {
+        int cnt = in.range(0, 4);
+        for (int i = 1; i <= cnt; ++i) {
+            words.push_back(in.str("ab", 1, 2));
+            lineOf.push_back(line);
+            idxOf.push_back(i);
+        }
+    }
+    for (std::size_t i = 0; i < words.size(); ++i) tokens.push_back({words[i], lineOf[i], idxOf[i]});
+
+    std::vector<TAnswer> expected = fuzz::oracle([&] {
+        std::string pat, text;
+        for (std::size_t j = 0; j < pattern.size(); ++j) pat += (j ? " " : "") + pattern[j];
+        std::vector<const TToken*> owner; // слово каждого символа, nullptr у пробелов
+        for (std::size_t i = 0; i < tokens.size(); ++i) {
+            if (i) {
+                text += ' ';
+                owner.push_back(nullptr);
+            }
+            text += tokens[i].word;
+            owner.insert(owner.end(), tokens[i].word.size(), &tokens[i]);
+        }
+        std::vector<TAnswer> ans;
+        for (std::size_t p = 0; p + pat.size() <= text.size(); ++p)
+            if (owner[p] && text.compare(p, pat.size(), pat) == 0) ans.push_back({owner[p]->line, owner[p]->idx});
+        return ans;
+    });
+    std::vector<TAnswer> got = fuzz::candidate([&] { return findPattern(pattern, tokens); });
+
+    FUZZ_CHECK(got.size() == expected.size(),
+               std::to_string(got.size()) + " matches, expected " + std::to_string(expected.size()));
+    for (std::size_t i = 0; i < got.size(); ++i)
+        FUZZ_CHECK(got[i].strPos == expected[i].strPos && got[i].wordPos == expected[i].wordPos,
+                   "match " + std::to_string(i));
+    return 0;
+}
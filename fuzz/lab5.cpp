@@ -0,0 +1,77 @@
+// Наибольшие общие подстроки: суффиксное дерево (в куче и в арене),
+// суффиксный массив и индекс на диске (--build-index, затем --query-index)
+// против перебора подстрок.
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fuzz.hpp"
+#include "../lab5/suffix_tree.hpp"
+#include "../lab5/suffix_array.hpp"
+
+namespace {
+
+using Answer = std::pair<int, std::vector<std::string>>;
+
+Answer brute(const std::string& s1, const std::string& s2) {
+    for (int len = static_cast<int>(std::min(s1.size(), s2.size())); len > 0; --len) {
+        std::set<std::string> common;
+        for (std::size_t i = 0; i + len <= s1.size(); ++i) {
+            std::string sub = s1.substr(i, len);
+            if (s2.find(sub) != std::string::npos) common.insert(sub);
+        }
+        if (!common.empty()) return {len, std::vector<std::string>(common.begin(), common.end())};
+    }
+    return {0, {}};
+}
+
+std::string show(const Answer& a) {
+    std::string s = std::to_string(a.first) + ":";
+    for (auto& x : a.second) s += " " + x;
+    return s;
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    fuzz::Input in(data, size);
+    // маленький алфавит — много повторов и длинные общие куски
+    std::string alphabet = in.flag() ? "ab" : "abcz";
+    std::string s1 = in.str(alphabet, 1, 40);
+    std::string s2 = in.str(alphabet, 1, 40);
+    std::string text = s1 + "$" + s2 + "#";
+    int posDollar = static_cast<int>(s1.size());
+    int posHash = posDollar + 1 + static_cast<int>(s2.size());
+
+    Answer expected = fuzz::oracle([&] { return brute(s1, s2); });
+    Answer tree = fuzz::candidate([&] {
+        SuffixTree st;
+        st.build(text);
+        return st.findLCSForTwoStrings(posDollar, posHash);
+    });
+    FUZZ_CHECK(tree == expected, "suffix tree " + show(tree) + ", expected " + show(expected));
+
+    arena::Arena mem;
+    {
+        SuffixTree st(mem);
+        st.build(text);
+        Answer got = st.findLCSForTwoStrings(posDollar, posHash);
+        FUZZ_CHECK(got == expected, "arena suffix tree " + show(got));
+    }
+    for (int threads : {1, 2}) {
+        Answer got = sa::findLCS(text, s1.size(), threads);
+        FUZZ_CHECK(got == expected, "suffix array, threads " + std::to_string(threads) + ": " + show(got));
+    }
+
+    // индекс строится по s1, как в main, и читается обратно через mmap
+    fuzz::TempFile file;
+    {
+        SuffixTree st;
+        st.build(s1 + '\0');
+        st.save(file.path());
+    }
+    Answer indexed = fuzz::candidate([&] { return SuffixIndex(file.path()).findLCS(s2); });
+    FUZZ_CHECK(indexed == expected, "suffix index " + show(indexed));
+    return 0;
+}
@@ -0,0 +1,170 @@
+// Динамика «-1, /2, /3»: dpk::fill с разбиением на шестёрки, компактные
+// режимы --packed и --checkpoint и таблицы --serve (дорастание, сохранение в
+// файл и отображение обратно) против исходного цикла с проверками делимости.
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "fuzz.hpp"
+#include "../lab6/dp_kernel.hpp"
+#include "../lab6/dp_solver.hpp"
+
+namespace {
+
+struct Tables {
+    std::vector<long long> dp;
+    std::vector<unsigned char> op;
+};
+
+// исходный цикл main
+Tables reference(int n) {
+    Tables t{std::vector<long long>(n + 1), std::vector<unsigned char>(n + 1)};
+    for (int x = 2; x <= n; ++x) {
+        t.dp[x] = t.dp[x - 1];
+        if (x % 2 == 0 && t.dp[x / 2] < t.dp[x]) {
+            t.dp[x] = t.dp[x / 2];
+            t.op[x] = 1;
+        }
+        if (x % 3 == 0 && t.dp[x / 3] < t.dp[x]) {
+            t.dp[x] = t.dp[x / 3];
+            t.op[x] = 2;
+        }
+        t.dp[x] += x;
+    }
+    return t;
+}
+
+// ответ программы на n: значение и путь
+std::string expectedAnswer(const Tables& t, int n) {
+    if (n < 1) return "-1\n\n";
+    static const char* names[3] = {"-1 ", "/2 ", "/3 "};
+    std::string s = std::to_string(t.dp[n]) + "\n";
+    for (int cur = n; cur > 1;) {
+        s += names[t.op[cur]];
+        cur = t.op[cur] == 0 ? cur - 1 : (t.op[cur] == 1 ? cur / 2 : cur / 3);
+    }
+    return s + "\n";
+}
+
+// всё, что f напишет в FastWriter; один временный файл на процесс
+template <class F>
+std::string capture(F&& f) {
+    static std::FILE* tmp = std::tmpfile();
+    const int fd = fileno(tmp);
+    FUZZ_CHECK(::ftruncate(fd, 0) == 0 && ::lseek(fd, 0, SEEK_SET) == 0);
+    {
+        FastWriter out(fd, 1 << 12);
+        f(out);
+    }
+    std::string s;
+    char buf[4096];
+    for (off_t at = 0;;) {
+        ssize_t got = ::pread(fd, buf, sizeof(buf), at);
+        if (got <= 0) break;
+        s.append(buf, static_cast<std::size_t>(got));
+        at += got;
+    }
+    return s;
+}
+
+void fuzzKernel(fuzz::Input& in) {
+    int n = in.flag() ? in.range(1, 64) : in.range(1, 200000);
+    Tables ref = fuzz::oracle([&] { return reference(n); });
+
+    // диапазон заполняется кусками случайной длины, чтобы проверить и стыки между вызовами
+    std::vector<int> cuts;
+    for (int from = 1; from <= n;) {
+        int to = in.empty() ? n : std::min(n, from + in.range(0, 40));
+        cuts.push_back(to);
+        from = to + 1;
+    }
+    std::vector<long long> dp(n + 1);
+    std::vector<unsigned char> op(n + 1);
+    fuzz::candidate([&] {
+        int from = 1;
+        for (int to : cuts) {
+            dpk::fill(dp.data(), op.data(), from, to);
+            from = to + 1;
+        }
+    });
+
+    for (int x = 1; x <= n; ++x)
+        FUZZ_CHECK(ref.dp[x] == dp[x] && ref.op[x] == op[x], "x = " + std::to_string(x));
+}
+
+void fuzzCompact(fuzz::Input& in) {
+    int n = in.flag() ? in.range(1, 64) : in.range(1, 200000);
+    bool packed = in.flag();
+    int K = in.range(1, 300);
+    std::string expected = fuzz::oracle([&] { return expectedAnswer(reference(n), n); });
+    std::string got = fuzz::candidate([&] { return capture([&](FastWriter& out) { solveCompact(n, packed, K, out); }); });
+    FUZZ_CHECK(got == expected,
+               std::string(packed ? "packed" : "checkpoint K = " + std::to_string(K)) + ", n = " + std::to_string(n));
+}
+
+// Поток запросов --serve: запросы, в том числе n < 1, перемежаются
+// сохранением таблицы в файл и загрузкой её в новую таблицу, в том числе из
+// обрезанного файла, который должен быть отвергнут.
+void fuzzServe(fuzz::Input& in) {
+    const int maxN = in.flag() ? 64 : 5000;
+    Tables ref = fuzz::oracle([&] { return reference(maxN); });
+
+    auto table = std::make_unique<DpTable>();
+    int step = 0;
+    while (!in.empty()) {
+        std::string where = "step " + std::to_string(step++);
+        int kind = in.range(0, 7);
+        if (kind < 5) {
+            int n = in.range(-2, maxN);
+            std::string expected = expectedAnswer(ref, n);
+            std::string got = fuzz::candidate([&] { return capture([&](FastWriter& out) { table->answer(n, out); }); });
+            FUZZ_CHECK(got == expected, where + ": n = " + std::to_string(n));
+        } else if (kind == 5) {
+            int n = in.range(1, maxN);
+            fuzz::candidate([&] { table->grow(n); });
+            FUZZ_CHECK(table->size() >= n, where + ": grow " + std::to_string(n));
+        } else {
+            fuzz::TempFile file;
+            table->save(file.path());
+            const int size = table->size();
+            if (kind == 7) {
+                // обрезанный файл отвергается, таблица остаётся прежней
+                std::FILE* f = std::fopen(file.path().c_str(), "rb");
+                std::fseek(f, 0, SEEK_END);
+                long len = std::ftell(f);
+                std::fclose(f);
+                FUZZ_CHECK(::truncate(file.path().c_str(), in.range(0, static_cast<int>(len) - 1)) == 0);
+                bool rejected = false;
+                try {
+                    table->load(file.path());
+                } catch (const std::runtime_error&) {
+                    rejected = true;
+                }
+                FUZZ_CHECK(rejected && table->size() == size, where + ": truncated table accepted");
+            } else {
+                table = std::make_unique<DpTable>();
+                fuzz::candidate([&] { table->load(file.path()); });
+                FUZZ_CHECK(table->size() == size, where + ": loaded " + std::to_string(table->size()) +
+                                                      " entries, saved " + std::to_string(size));
+            }
+        }
+    }
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    fuzz::Input in(data, size);
+    int mode = in.range(0, 2);
+    if (mode == 0)
+        fuzzKernel(in);
+    else if (mode == 1)
+        fuzzCompact(in);
+    else
+        fuzzServe(in);
+    return 0;
+}
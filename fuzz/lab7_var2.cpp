@@ -0,0 +1,167 @@
+// Покрытие отрезками: поразрядная сортировка и жадный проход, CoverIndex и
+// DynamicCover против исходного жадного алгоритма по отсортированному
+// std::stable_sort набору, пересчитываемого на каждый запрос.
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "fuzz.hpp"
+#include "../lab7/var2/cover.hpp"
+
+namespace {
+
+// Жадно покрывает [a, b]: из отрезков с L <= cur берётся первый по порядку
+// с наибольшим R. Возвращает число отрезков или -1; sorted — по (L, idx).
+int greedy(const std::vector<Seg>& sorted, int a, int b, std::vector<Seg>& path) {
+    path.clear();
+    for (int cur = a; cur < b;) {
+        const Seg* best = nullptr;
+        for (const Seg& s : sorted) {
+            if (s.L > cur) break;
+            if (!best || s.R > best->R) best = &s;
+        }
+        if (!best || best->R <= cur) return -1;
+        path.push_back(*best);
+        cur = best->R;
+    }
+    return static_cast<int>(path.size());
+}
+
+std::vector<Seg> sortedCopy(std::vector<Seg> v) {
+    std::stable_sort(v.begin(), v.end(), [](const Seg& x, const Seg& y) { return x.L < y.L; });
+    return v;
+}
+
+bool same(const std::vector<Seg>& x, const std::vector<Seg>& y) {
+    return std::equal(x.begin(), x.end(), y.begin(), y.end(),
+                      [](const Seg& p, const Seg& q) { return p.L == q.L && p.R == q.R && p.idx == q.idx; });
+}
+
+Seg readSeg(fuzz::Input& in, int idx) {
+    Seg s;
+    s.L = in.range(-8, 24);
+    s.R = s.L + in.range(0, 12);
+    s.idx = idx;
+    return s;
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    fuzz::Input in(data, size);
+    int mode = in.range(0, 2);
+    std::vector<Seg> segs(in.range(0, 24));
+    for (int i = 0; i < static_cast<int>(segs.size()); ++i) segs[i] = readSeg(in, i);
+    const int N = static_cast<int>(segs.size());
+
+    if (mode == 0) {
+        // одно покрытие [0, M], как solve_fast
+        int M = in.range(0, 24);
+        std::vector<Seg> expected, got;
+        int cnt = fuzz::oracle([&] { return greedy(sortedCopy(segs), 0, M, expected); });
+        bool ok = fuzz::candidate([&] {
+            std::vector<Seg> v = segs;
+            radix_sort_by_L(v);
+            return greedy_cover_sorted(v, M, got);
+        });
+        FUZZ_CHECK(ok == (cnt >= 0));
+        if (ok) {
+            FUZZ_CHECK(same(got, expected), "M = " + std::to_string(M));
+            std::vector<Seg> byIdx = expected;
+            std::sort(byIdx.begin(), byIdx.end(), [](const Seg& x, const Seg& y) { return x.idx < y.idx; });
+            FUZZ_CHECK(same(order_by_idx(got, N), byIdx));
+        }
+    } else if (mode == 1) {
+        // запросы [a, b] к одному набору, как solve_queries
+        std::vector<std::pair<int, int>> queries;
+        while (!in.empty()) {
+            int a = in.range(-10, 30);
+            queries.emplace_back(a, a + in.range(-2, 20));
+        }
+        std::vector<int> cnt0(queries.size()), cnt1(queries.size());
+        std::vector<std::vector<Seg>> path0(queries.size()), path1(queries.size());
+        fuzz::oracle([&] {
+            std::vector<Seg> sorted = sortedCopy(segs);
+            for (std::size_t q = 0; q < queries.size(); ++q)
+                cnt0[q] = greedy(sorted, queries[q].first, queries[q].second, path0[q]);
+        });
+        fuzz::candidate([&] {
+            CoverIndex index(segs);
+            for (std::size_t q = 0; q < queries.size(); ++q)
+                cnt1[q] = index.query(queries[q].first, queries[q].second, &path1[q]);
+        });
+        for (std::size_t q = 0; q < queries.size(); ++q) {
+            std::string where = "[" + std::to_string(queries[q].first) + ", " + std::to_string(queries[q].second) + "]";
+            FUZZ_CHECK(cnt0[q] == cnt1[q], where + ": " + std::to_string(cnt1[q]) + ", expected " + std::to_string(cnt0[q]));
+            if (cnt0[q] > 0) FUZZ_CHECK(same(path0[q], path1[q]), where);
+        }
+    } else {
+        // вставки, удаления и запросы покрытия [0, M], как solve_dynamic
+        int M = in.range(0, 24);
+        struct Op {
+            char c;
+            Seg s;
+        };
+        std::vector<Op> ops;
+        std::vector<Seg> all = segs;
+        while (!in.empty()) {
+            int k = in.range(0, 2);
+            if (k == 0) {
+                all.push_back(readSeg(in, static_cast<int>(all.size())));
+                ops.push_back({'+', all.back()});
+            } else if (k == 1 && !all.empty()) {
+                ops.push_back({'-', all[in.range(0, static_cast<int>(all.size()) - 1)]});
+            } else {
+                ops.push_back({'?', Seg()});
+            }
+        }
+
+        std::vector<int> cnt0, cnt1;
+        std::vector<std::vector<Seg>> res0, res1;
+        fuzz::oracle([&] {
+            std::vector<Seg> alive = segs, path;
+            for (const Op& op : ops) {
+                if (op.c == '+') {
+                    alive.push_back(op.s);
+                } else if (op.c == '-') {
+                    auto it = std::find_if(alive.begin(), alive.end(), [&](const Seg& s) { return s.idx == op.s.idx; });
+                    if (it != alive.end()) alive.erase(it);
+                } else {
+                    std::vector<Seg> sorted = alive;
+                    std::sort(sorted.begin(), sorted.end(),
+                              [](const Seg& x, const Seg& y) { return x.L != y.L ? x.L < y.L : x.idx < y.idx; });
+                    cnt0.push_back(greedy(sorted, 0, M, path));
+                    res0.push_back(path);
+                }
+            }
+        });
+        fuzz::candidate([&] {
+            DynamicCover set;
+            std::vector<char> alive(all.size(), 0);
+            for (const Seg& s : segs) {
+                set.insert(s);
+                alive[s.idx] = 1;
+            }
+            std::vector<Seg> res;
+            for (const Op& op : ops) {
+                if (op.c == '+') {
+                    set.insert(op.s);
+                    alive[op.s.idx] = 1;
+                } else if (op.c == '-') {
+                    bool found = set.erase(op.s);
+                    FUZZ_CHECK(found == static_cast<bool>(alive[op.s.idx]), "erase " + std::to_string(op.s.idx));
+                    alive[op.s.idx] = 0;
+                } else {
+                    bool ok = set.cover(M, res);
+                    cnt1.push_back(ok ? static_cast<int>(res.size()) : -1);
+                    res1.push_back(res);
+                }
+            }
+        });
+        for (std::size_t q = 0; q < cnt0.size(); ++q) {
+            FUZZ_CHECK(cnt0[q] == cnt1[q], "query " + std::to_string(q));
+            if (cnt0[q] > 0) FUZZ_CHECK(same(res0[q], res1[q]), "query " + std::to_string(q));
+        }
+    }
+    return 0;
+}
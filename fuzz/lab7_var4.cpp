@@ -0,0 +1,97 @@
+// Жадный выбор строк по цене: ModularBasis, IncrementalBasis,
+// screen_parallel и select_dense (--dense) против исходного пересчёта
+// rank_matrix на каждую строку; rank_dense — против rank_matrix всей матрицы.
+// Элементы маленькие, поэтому long double в эталоне считает точно.
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "fuzz.hpp"
+#include "../lab7/var4/basis.hpp"
+
+namespace {
+
+std::string show(const std::vector<int>& v) {
+    std::string s;
+    for (int x : v) s += " " + std::to_string(x);
+    return s;
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    fuzz::Input in(data, size);
+    const int N = in.range(1, 6);
+    const int M = in.range(0, 16);
+    // строки с повторами и нулями, чтобы зависимости были частыми
+    const int lo = in.flag() ? -1 : -3, hi = -lo;
+    std::vector<std::vector<int>> rows(M, std::vector<int>(N));
+    std::vector<int> price(M);
+    for (int i = 0; i < M; ++i) {
+        for (int& x : rows[i]) x = in.range(lo, hi);
+        price[i] = in.range(0, 7);
+    }
+    std::vector<int> ord(M);
+    std::iota(ord.begin(), ord.end(), 0);
+    std::stable_sort(ord.begin(), ord.end(), [&](int a, int b) { return price[a] < price[b]; });
+
+    std::vector<int> expected = fuzz::oracle([&] {
+        std::vector<std::vector<long double>> chosen;
+        std::vector<int> res;
+        for (int id : ord) {
+            if (static_cast<int>(res.size()) == N) break;
+            chosen.emplace_back(rows[id].begin(), rows[id].end());
+            if (rank_matrix(chosen) > static_cast<int>(res.size()))
+                res.push_back(id);
+            else
+                chosen.pop_back();
+        }
+        return res;
+    });
+    std::vector<int> got = fuzz::candidate([&] {
+        ModularBasis basis(N);
+        std::vector<int> res;
+        for (int id : ord) {
+            if (basis.try_add(rows[id])) {
+                res.push_back(id);
+                if (basis.rank() == N) break;
+            }
+        }
+        return res;
+    });
+    FUZZ_CHECK(got == expected, "modular:" + show(got) + ", expected:" + show(expected));
+
+    IncrementalBasis inc(N);
+    std::vector<int> incRes;
+    for (int id : ord)
+        if (static_cast<int>(incRes.size()) < N && inc.try_add(rows[id])) incRes.push_back(id);
+    FUZZ_CHECK(incRes == expected, "incremental:" + show(incRes));
+
+    std::vector<const std::vector<int>*> cand;
+    for (int id : ord) cand.push_back(&rows[id]);
+    for (int threads : {1, 2}) {
+        std::vector<int> par;
+        for (int p : screen_parallel(cand, N, threads, in.range(1, 8))) par.push_back(ord[p]);
+        FUZZ_CHECK(par == expected, "screen_parallel, threads " + std::to_string(threads) + ":" + show(par));
+    }
+    std::vector<int> dense;
+    for (int p : select_dense(cand, N)) dense.push_back(ord[p]);
+    FUZZ_CHECK(dense == expected, "select_dense:" + show(dense));
+
+    // допуск относительный: умножение на степень двойки, точное в double, ранг не меняет
+    int rank = fuzz::oracle([&] {
+        std::vector<std::vector<long double>> all;
+        for (auto& r : rows) all.emplace_back(r.begin(), r.end());
+        return rank_matrix(all);
+    });
+    const int shift = in.range(-60, 60);
+    Matrix a(M, N);
+    for (int i = 0; i < M; ++i)
+        for (int j = 0; j < N; ++j) a.row(i)[j] = std::ldexp(rows[i][j], shift);
+    int denseRank = fuzz::candidate([&] { return rank_dense(a); });
+    FUZZ_CHECK(denseRank == rank, "rank_dense " + std::to_string(denseRank) + ", expected " + std::to_string(rank) +
+                                 ", scale 2^" + std::to_string(shift));
+    return 0;
+}
@@ -0,0 +1,237 @@
+// Паросочетания: Кун с ускорениями, Хопкрофт–Карп (и параллельный),
+// динамическое паросочетание и движки назначения против исходного
+// рекурсивного Куна на списках смежности и перебора назначений.
+#include <algorithm>
+#include <memory_resource>
+#include <queue>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fuzz.hpp"
+#include "../lab8/matching.hpp"
+#include "../lab8/parallel_matching.hpp"
+#include "../lab8/dynamic_matching.hpp"
+#include "../lab8/assignment.hpp"
+
+namespace {
+
+// исходный движок: отсортированные списки соседей и рекурсивный Кун
+struct KuhnLists {
+    std::vector<std::vector<int>> adj;
+    std::vector<int> matchR;
+    std::vector<char> used;
+
+    KuhnLists(int n, const std::vector<std::pair<int, int>>& edges) : adj(n) {
+        for (auto& e : edges) {
+            adj[e.first].push_back(e.second);
+            adj[e.second].push_back(e.first);
+        }
+        for (auto& a : adj) std::sort(a.begin(), a.end());
+    }
+
+    bool dfs(int v) {
+        if (used[v]) return false;
+        used[v] = 1;
+        for (int u : adj[v]) {
+            if (matchR[u] == -1 || dfs(matchR[u])) {
+                matchR[u] = v;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int run(const std::vector<int>& lefts) {
+        matchR.assign(adj.size(), -1);
+        int matched = 0;
+        for (int v : lefts) {
+            used.assign(adj.size(), 0);
+            if (dfs(v)) ++matched;
+        }
+        return matched;
+    }
+};
+
+// вершины 1..n, доли — по раскраске обходом в ширину, как в main
+std::vector<int> leftsOf(const Graph& g) {
+    std::vector<int> color(g.size(), -1), lefts;
+    for (int s = 1; s < g.size(); ++s) {
+        if (color[s] != -1) continue;
+        color[s] = 0;
+        std::queue<int> q;
+        q.push(s);
+        while (!q.empty()) {
+            int v = q.front();
+            q.pop();
+            for (const int* p = g.begin(v); p != g.end(v); ++p)
+                if (color[*p] == -1) {
+                    color[*p] = color[v] ^ 1;
+                    q.push(*p);
+                }
+        }
+    }
+    for (int v = 1; v < g.size(); ++v)
+        if (color[v] == 0) lefts.push_back(v);
+    return lefts;
+}
+
+// matchR — корректное паросочетание графа размера size
+void checkMatching(const Graph& g, const std::vector<int>& matchR, int size, const char* engine) {
+    std::vector<int> seen(g.size(), 0);
+    int cnt = 0;
+    for (int u = 0; u < g.size(); ++u) {
+        int v = matchR[u];
+        if (v == -1) continue;
+        ++cnt;
+        FUZZ_CHECK(std::find(g.begin(v), g.end(v), u) != g.end(v), std::string(engine) + ": not an edge");
+        FUZZ_CHECK(++seen[v] == 1 && matchR[v] == -1, std::string(engine) + ": vertex matched twice");
+    }
+    FUZZ_CHECK(cnt == size, std::string(engine) + ": size " + std::to_string(cnt) + ", expected " + std::to_string(size));
+}
+
+void fuzzMatching(fuzz::Input& in) {
+    const int n = in.range(1, 24);
+    std::vector<int> side(n + 1);
+    for (int v = 1; v <= n; ++v) side[v] = in.flag();
+    std::vector<std::pair<int, int>> edges;
+    for (int m = in.range(0, 48); m > 0; --m) {
+        int a = in.range(1, n), b = in.range(1, n);
+        if (side[a] != side[b]) edges.emplace_back(a, b); // граф двудольный, повторы рёбер допустимы
+    }
+    Graph g = build_graph(n + 1, edges);
+    std::vector<int> lefts = leftsOf(g);
+
+    KuhnLists ref(n + 1, edges);
+    int expected = fuzz::oracle([&] { return ref.run(lefts); });
+
+    // тот же порядок перебора — то же паросочетание, а не только размер
+    std::vector<int> matchR;
+    int got = fuzz::candidate([&] { return Kuhn(g, matchR).run(lefts); });
+    FUZZ_CHECK(got == expected && matchR == ref.matchR, "kuhn");
+
+    for (int o = 1; o < 4; ++o) {
+        KuhnOptions opt;
+        opt.warmStart = o & 1;
+        opt.epochMarks = o & 2;
+        int size = Kuhn(g, matchR, opt).run(lefts);
+        FUZZ_CHECK(size == expected, "kuhn options " + std::to_string(o));
+        checkMatching(g, matchR, expected, "kuhn options");
+    }
+    HopcroftKarp(g, lefts, matchR).run();
+    checkMatching(g, matchR, expected, "hopcroft-karp");
+    pm::HopcroftKarpParallel(g, lefts, matchR, 2).run();
+    checkMatching(g, matchR, expected, "parallel hopcroft-karp");
+
+    // --dynamic: добавления и удаления рёбер, после каждого — пересчёт с нуля
+    std::set<std::pair<int, int>> present;
+    for (auto e : edges) present.insert(std::minmax(e.first, e.second));
+    edges.assign(present.begin(), present.end());
+    g = build_graph(n + 1, edges);
+    HopcroftKarp(g, leftsOf(g), matchR).run();
+    std::pmr::unsynchronized_pool_resource pool;
+    DynamicMatching dm(g, matchR, &pool);
+    while (!in.empty()) {
+        int a = in.range(1, n), b = in.range(1, n);
+        if (side[a] == side[b]) continue;
+        auto e = std::minmax(a, b);
+        if (in.flag()) {
+            if (!present.insert(e).second) continue;
+            fuzz::candidate([&] { dm.addEdge(a, b); });
+        } else {
+            if (!present.erase(e)) continue;
+            fuzz::candidate([&] { dm.removeEdge(a, b); });
+        }
+        std::vector<std::pair<int, int>> cur(present.begin(), present.end());
+        Graph h = build_graph(n + 1, cur);
+        KuhnLists now(n + 1, cur);
+        int size = fuzz::oracle([&] { return now.run(leftsOf(h)); });
+        FUZZ_CHECK(dm.size() == size, "dynamic size " + std::to_string(dm.size()) + ", expected " + std::to_string(size));
+        for (int v = 1; v <= n; ++v) {
+            int p = dm.partner(v);
+            if (p == -1) continue;
+            FUZZ_CHECK(dm.partner(p) == v && present.count(std::minmax(v, p)), "dynamic partner of " + std::to_string(v));
+        }
+    }
+}
+
+// Наибольшее паросочетание наименьшей стоимости перебором. Стоимость пары —
+// самое дешёвое из её рёбер.
+std::pair<int, long long> bruteAssign(int nL, int nR, const std::vector<WeightedEdge>& edges) {
+    const long long NONE = 1LL << 60;
+    std::vector<std::vector<long long>> w(nL, std::vector<long long>(nR, NONE));
+    for (auto& e : edges) w[e.l][e.r] = std::min(w[e.l][e.r], e.w);
+    std::pair<int, long long> best{0, 0};
+    std::vector<char> usedR(nR, 0);
+    auto go = [&](auto&& self, int l, int size, long long cost) -> void {
+        if (l == nL) {
+            if (size > best.first || (size == best.first && cost < best.second)) best = {size, cost};
+            return;
+        }
+        self(self, l + 1, size, cost);
+        for (int r = 0; r < nR; ++r) {
+            if (usedR[r] || w[l][r] == NONE) continue;
+            usedR[r] = 1;
+            self(self, l + 1, size + 1, cost + w[l][r]);
+            usedR[r] = 0;
+        }
+    };
+    go(go, 0, 0, 0);
+    return best;
+}
+
+void checkAssignment(int nL, int nR, const std::vector<WeightedEdge>& edges, const Assignment& a,
+                     std::pair<int, long long> expected, const char* engine) {
+    std::string name = engine;
+    FUZZ_CHECK(static_cast<int>(a.matchR.size()) == nR, name);
+    std::vector<char> usedL(nL, 0);
+    int size = 0;
+    long long cost = 0;
+    for (int r = 0; r < nR; ++r) {
+        int l = a.matchR[r];
+        if (l == -1) continue;
+        FUZZ_CHECK(l >= 0 && l < nL && !usedL[l], name + ": bad left vertex");
+        usedL[l] = 1;
+        long long w = 1LL << 60;
+        for (auto& e : edges)
+            if (e.l == l && e.r == r) w = std::min(w, e.w);
+        FUZZ_CHECK(w != 1LL << 60, name + ": not an edge");
+        ++size;
+        cost += w;
+    }
+    FUZZ_CHECK(size == expected.first && a.size == size,
+               name + ": size " + std::to_string(size) + ", expected " + std::to_string(expected.first));
+    FUZZ_CHECK(cost == expected.second && a.cost == cost,
+               name + ": cost " + std::to_string(a.cost) + ", expected " + std::to_string(expected.second));
+}
+
+void fuzzAssignment(fuzz::Input& in) {
+    const int nL = in.range(1, 6), nR = in.range(1, 6);
+    std::vector<WeightedEdge> edges;
+    while (!in.empty()) {
+        WeightedEdge e;
+        e.l = in.range(0, nL - 1);
+        e.r = in.range(0, nR - 1);
+        e.w = in.range(-20, 20);
+        edges.push_back(e);
+    }
+    auto expected = fuzz::oracle([&] { return bruteAssign(nL, nR, edges); });
+    Assignment a = fuzz::candidate([&] { return assign(nL, nR, edges); });
+    checkAssignment(nL, nR, edges, a, expected, "assign");
+    checkAssignment(nL, nR, edges, hungarian(nL, nR, edges), expected, "hungarian");
+    checkAssignment(nL, nR, edges, primalDual(nL, nR, edges), expected, "primal-dual");
+    checkAssignment(nL, nR, edges, auction(nL, nR, edges), expected, "auction");
+    checkAssignment(nL, nR, edges, auction(nL, nR, edges, 2), expected, "auction, 2 threads");
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    fuzz::Input in(data, size);
+    if (in.flag())
+        fuzzAssignment(in);
+    else
+        fuzzMatching(in);
+    return 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <algorithm>
+
+constexpr size_t MAX_KEY = 1000000;
+
+struct Item {
+    size_t key;
+    std::string value;
+};
+
+inline size_t maxKey(std::vector<Item> items) {
+    size_t maxK = 0;
+    for (const auto& item : items) {
+        maxK = std::max(maxK, item.key);
+    }
+    return maxK;
+}
+
+inline std::vector<Item> countingSort(std::vector<Item> items) {
+    const size_t sizeCntVect = MAX_KEY;
+    std::vector<size_t> cntVect(sizeCntVect, 0);
+    // size_t* cntVect = new size_t[sizeCntVect]();
+
+    for (const auto& item : items) {
+        ++cntVect[item.key];
+    }
+
+    for (size_t i = 1; i < sizeCntVect; ++i) {
+        cntVect[i] += cntVect[i - 1];
+    }
+
+    std::vector<Item> res(items.size());
+    size_t i = items.size();
+    while (i-- > 0) {
+        size_t index = --cntVect[items[i].key];
+        res[index] = std::move(items[i]);
+    }
+
+    // delete[] cntVect;
+
+    return res;
+}
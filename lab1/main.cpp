@@ -1,64 +1,38 @@
-#include <iostream>
 #include <vector>
 #include <string>
-#include <iomanip>
 
-constexpr size_t MAX_KEY = 1000000;
-
-struct Item {
-    size_t key;
-    std::string value;
-};
-
-size_t maxKey(std::vector<Item> items) {
-    size_t maxK = 0;
-    for (const auto& item : items) {
-        maxK = std::max(maxK, item.key);
-    }
-    return maxK;
-}
-
-std::vector<Item> countingSort(std::vector<Item> items) {
-    const size_t sizeCntVect = MAX_KEY;
-    std::vector<size_t> cntVect(sizeCntVect, 0);
-    // size_t* cntVect = new size_t[sizeCntVect]();
-
-    for (const auto& item : items) {
-        ++cntVect[item.key];
-    }
-
-    for (size_t i = 1; i < sizeCntVect; ++i) {
-        cntVect[i] += cntVect[i - 1];
-    }
-
-    std::vector<Item> res(items.size());
-    size_t i = items.size();
-    while (i-- > 0) {
-        size_t index = --cntVect[items[i].key];
-        res[index] = std::move(items[i]);
-    }
-
-    // delete[] cntVect;
-
-    return res;
-}
+#include "counting_sort.hpp"
+#include "../common/fastio.hpp"
+#include "../common/instrument.hpp"
 
 int main() {
+    LAB_PHASE("parse");
+    FastReader in;
+    FastWriter out;
+
     std::vector<Item> items;
     size_t key;
     std::string value;
 
-    while(std::cin >> key >> value) {
+    while(in.readInt(key) && in.readToken(value)) {
         items.push_back({
             .key = key,
             .value = std::move(value),
         });
     }
 
-    items = countingSort(std::move(items));
+    {
+        LAB_PHASE("build");
+        items = countingSort(std::move(items));
+    }
+
+    LAB_PHASE("output");
 
     for (const auto& [key, value] : items) {
-        std::cout << std::setfill('0') << std::setw(6) << key << '\t' << value << '\n';
+        out.writeUIntPadded(key, 6);
+        out.put('\t');
+        out.write(value);
+        out.put('\n');
     }
 
     return 0;
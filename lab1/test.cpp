@@ -6,42 +6,15 @@
 #include <iomanip>
 #include <algorithm>
 
-constexpr size_t MAX_KEY = 1000000;
-
-struct Item {
-    size_t key;
-    std::string value;
-};
+#include "counting_sort.hpp"
 
 // Функция сравнения для std::sort
 bool compareItems(const Item& a, const Item& b) {
     return a.key < b.key;
 }
 
-std::vector<Item> countingSort(std::vector<Item> items) {
-    std::vector<size_t> cntVect(MAX_KEY, 0);
-
-    for (const auto& item : items) {
-        ++cntVect[item.key];
-    }
-
-    for (size_t i = 1; i < MAX_KEY; ++i) {
-        cntVect[i] += cntVect[i - 1];
-    }
-
-    std::vector<Item> res(items.size());
-    size_t i = items.size();
-    while (i-- > 0) {
-        size_t index = --cntVect[items[i].key];
-        res[index] = std::move(items[i]);
-    }
-
-    return res;
-}
-
 int main() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(1);
     std::uniform_int_distribution<> key_dist(0, 999999);
     std::uniform_int_distribution<> len_dist(1, 2048);
 
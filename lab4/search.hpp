@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <algorithm>
+
+struct TAnswer { int strPos, wordPos; };
+
+// Слово текста в нижнем регистре, его строка и номер в строке (с 1). Символы
+// слова принадлежат вызывающему (в main — арене на весь текст).
+struct TToken { std::string_view word; int line, idx; };
+
+inline std::vector<int> computeZ(const std::string& s) {
+    int n = s.size();
+    std::vector<int> z(n, 0);
+    int l = 0, r = 0;
+    for (int i = 1; i < n; ++i) {
+        if (i <= r) z[i] = std::min(z[i - l], r - i + 1);
+        while (i + z[i] < n && s[z[i]] == s[i + z[i]]) {
+            ++z[i];
+        }
+        if (i + z[i] - 1 > r) {
+            l = i; r = i + z[i] - 1;
+        }
+    }
+    return z;
+}
+
+// Вхождения образца — слов через один пробел — в текст, склеенный из tokens
+// так же: Z-функция строки «образец \x01 текст». Ответ — строка и номер слова,
+// с которого начинается вхождение, в порядке текста.
+inline std::vector<TAnswer> findPattern(const std::vector<std::string>& patTokens,
+                                        const std::vector<TToken>& tokens) {
+    std::string pattern;
+    for (size_t i = 0; i < patTokens.size(); ++i) {
+        if (i) pattern.push_back(' ');
+        pattern += patTokens[i];
+    }
+    int P = pattern.size();
+
+    std::string text;
+    text.reserve(tokens.size() * 8);
+    std::vector<std::pair<int,int>> charMap;
+    charMap.reserve(tokens.size() * 8);
+
+    bool first = true;
+    for (auto &tk : tokens) {
+        if (!first) {
+            text.push_back(' ');
+            charMap.emplace_back(tk.line, 0);
+        }
+        first = false;
+        for (char c : tk.word) {
+            text.push_back(c);
+            charMap.emplace_back(tk.line, tk.idx);
+        }
+    }
+
+    std::string S;
+    S.reserve(P + 1 + text.size());
+    S += pattern;
+    S.push_back('\x01');
+    S += text;
+
+    auto Z = computeZ(S);
+
+    std::vector<TAnswer> ans;
+    int N = S.size();
+    for (int i = P + 1; i < N; ++i) {
+        if (Z[i] == P) {
+            int pos = i - P - 1;
+            if (pos >= 0 && pos < (int)charMap.size()) {
+                auto [ln, wd] = charMap[pos];
+                if (wd > 0) {
+                    ans.push_back({ln, wd});
+                }
+            }
+        }
+    }
+
+    return ans;
+}
@@ -7,7 +7,7 @@
 #include <cstdlib>
 
 std::string generate_random_word(int max_length) {
-    static std::mt19937 gen(std::random_device{}());
+    static std::mt19937 gen(4);
     static std::uniform_int_distribution<> len_dist(1, max_length);
     static std::uniform_int_distribution<> char_dist('a', 'z');
 
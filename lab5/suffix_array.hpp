@@ -0,0 +1,186 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+// Параллельное построение суффиксного массива удвоением префиксов.
+// Каждый раунд сортирует пары рангов (rank[i], rank[i+k]) поразрядной
+// сортировкой (LSD, 8 бит на проход) с гистограммами на поток, затем
+// пересчитывает ранги параллельным префиксным суммированием.
+// Индексы 32-битные: длина текста должна быть меньше 2^32 - 1.
+
+namespace sa {
+
+using u32 = std::uint32_t;
+using u64 = std::uint64_t;
+
+template <class F>
+void parallelFor(int threads, std::size_t n, F fn) {
+    if (threads <= 1 || n < 4096) {
+        fn(std::size_t(0), n, 0);
+        return;
+    }
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    std::size_t chunk = (n + threads - 1) / threads;
+    for (int t = 1; t < threads; ++t) {
+        std::size_t b = std::min(n, chunk * t), e = std::min(n, b + chunk);
+        pool.emplace_back(fn, b, e, t);
+    }
+    fn(std::size_t(0), std::min(n, chunk), 0);
+    for (auto &th : pool) th.join();
+}
+
+struct KeyIdx {
+    u64 key;
+    u32 idx;
+};
+
+// Стабильная LSD-сортировка по младшим key_bits битам ключа.
+inline void radixSort(std::vector<KeyIdx> &a, std::vector<KeyIdx> &tmp, int key_bits, int threads) {
+    const std::size_t n = a.size();
+    if (n < 4096) threads = 1;
+    std::vector<std::size_t> hist((std::size_t)threads * 256);
+    tmp.resize(n);
+
+    for (int shift = 0; shift < key_bits; shift += 8) {
+        std::fill(hist.begin(), hist.end(), 0);
+        parallelFor(threads, n, [&](std::size_t b, std::size_t e, int t) {
+            std::size_t *h = &hist[(std::size_t)t * 256];
+            for (std::size_t i = b; i < e; ++i) ++h[(a[i].key >> shift) & 255];
+        });
+        // смещения: сначала по цифре, внутри цифры — по номеру потока
+        std::size_t sum = 0;
+        for (int d = 0; d < 256; ++d) {
+            for (int t = 0; t < threads; ++t) {
+                std::size_t c = hist[(std::size_t)t * 256 + d];
+                hist[(std::size_t)t * 256 + d] = sum;
+                sum += c;
+            }
+        }
+        parallelFor(threads, n, [&](std::size_t b, std::size_t e, int t) {
+            std::size_t *h = &hist[(std::size_t)t * 256];
+            for (std::size_t i = b; i < e; ++i) tmp[h[(a[i].key >> shift) & 255]++] = a[i];
+        });
+        a.swap(tmp);
+    }
+}
+
+inline int bitWidth(u64 x) {
+    int b = 0;
+    while (x) { ++b; x >>= 1; }
+    return b;
+}
+
+inline std::vector<u32> buildSuffixArray(const std::string &s, int threads) {
+    const std::size_t n = s.size();
+    std::vector<u32> sa(n);
+    if (n == 0) return sa;
+    threads = std::max(1, threads);
+
+    std::vector<u32> rank(n);
+    std::vector<KeyIdx> items(n), tmp;
+    parallelFor(threads, n, [&](std::size_t b, std::size_t e, int) {
+        for (std::size_t i = b; i < e; ++i) items[i] = {(u64)(unsigned char)s[i], (u32)i};
+    });
+    u32 classes = 256;
+    int key_bits = 8;
+
+    std::vector<u32> flags(n);
+    std::vector<u32> partial(threads);
+    for (std::size_t k = 1;; k <<= 1) {
+        radixSort(items, tmp, key_bits, threads);
+
+        // новый ранг = число различных ключей до позиции включительно
+        parallelFor(threads, n, [&](std::size_t b, std::size_t e, int t) {
+            u32 cnt = 0;
+            for (std::size_t i = b; i < e; ++i) {
+                flags[i] = (i == 0 || items[i].key != items[i - 1].key);
+                cnt += flags[i];
+            }
+            partial[t] = cnt;
+        });
+        const int used = (n < 4096) ? 1 : threads;
+        u32 acc = 0;
+        for (int t = 0; t < used; ++t) {
+            u32 c = partial[t];
+            partial[t] = acc;
+            acc += c;
+        }
+        classes = acc;
+        parallelFor(threads, n, [&](std::size_t b, std::size_t e, int t) {
+            u32 r = partial[t];
+            for (std::size_t i = b; i < e; ++i) {
+                r += flags[i];
+                rank[items[i].idx] = r; // ранги с 1, 0 — «за концом строки»
+            }
+        });
+        if (classes == n || k >= n) break;
+
+        const int rb = bitWidth(classes);
+        key_bits = 2 * rb;
+        parallelFor(threads, n, [&](std::size_t b, std::size_t e, int) {
+            for (std::size_t i = b; i < e; ++i) {
+                u32 p = items[i].idx;
+                u64 second = (p + k < n) ? rank[p + k] : 0;
+                items[i].key = ((u64)rank[p] << rb) | second;
+            }
+        });
+    }
+
+    parallelFor(threads, n, [&](std::size_t b, std::size_t e, int) {
+        for (std::size_t i = b; i < e; ++i) sa[i] = items[i].idx;
+    });
+    return sa;
+}
+
+// LCP соседних суффиксов (алгоритм Касаи): lcp[i] = lcp(sa[i-1], sa[i]).
+inline std::vector<u32> buildLCP(const std::string &s, const std::vector<u32> &sa) {
+    const std::size_t n = s.size();
+    std::vector<u32> rank(n), lcp(n, 0);
+    for (std::size_t i = 0; i < n; ++i) rank[sa[i]] = (u32)i;
+    std::size_t h = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (rank[i] == 0) { h = 0; continue; }
+        std::size_t j = sa[rank[i] - 1];
+        while (i + h < n && j + h < n && s[i + h] == s[j + h]) ++h;
+        lcp[rank[i]] = (u32)h;
+        if (h) --h;
+    }
+    return lcp;
+}
+
+// LCS по суффиксному массиву текста s1 + '$' + s2 + '#': ответ — максимальный
+// lcp среди соседних суффиксов из разных строк.
+inline std::pair<int, std::vector<std::string>> findLCS(const std::string &text, std::size_t pos_dollar, int threads) {
+    auto suf = buildSuffixArray(text, threads);
+    auto lcp = buildLCP(text, suf);
+
+    u32 max_len = 0;
+    std::vector<u32> starts;
+    for (std::size_t i = 1; i < suf.size(); ++i) {
+        bool a = suf[i - 1] < pos_dollar, b = suf[i] < pos_dollar;
+        if (a == b || lcp[i] == 0 || lcp[i] < max_len) continue;
+        if (lcp[i] > max_len) {
+            max_len = lcp[i];
+            starts.clear();
+        }
+        starts.push_back(suf[i]);
+    }
+
+    // соседи в суффиксном массиве уже упорядочены, остаётся убрать повторы
+    std::string_view tv(text);
+    std::vector<std::string> out;
+    for (u32 p : starts) {
+        std::string_view cur = tv.substr(p, max_len);
+        if (out.empty() || out.back() != cur) out.emplace_back(cur);
+    }
+    return {(int)max_len, out};
+}
+
+} // namespace sa
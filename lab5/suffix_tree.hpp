@@ -0,0 +1,460 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <string_view>
+#include <algorithm>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <memory_resource>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../common/arena.hpp"
+#include "../common/instrument.hpp"
+
+struct Node {
+    std::pmr::unordered_map<char,int> next; // char -> node index
+    int start;
+    int *end;      // inclusive
+    int link;      // suffix link
+    int example_s1; // example index from s1 in subtree (or -1)
+    int example_s2; // example index from s2 in subtree (or -1)
+    Node(int s = -1, int *e = nullptr, std::pmr::memory_resource *mr = std::pmr::get_default_resource())
+        : next(mr), start(s), end(e), link(-1), example_s1(-1), example_s2(-1) {}
+};
+
+// Плоское представление дерева для файла индекса: узлы в порядке BFS,
+// дети каждого узла лежат подряд и отсортированы по символу.
+struct IndexHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t node_count;
+    std::uint64_t text_len;
+    std::uint64_t edge_count;
+};
+
+struct FlatNode {
+    std::int32_t start;
+    std::int32_t end;      // inclusive
+    std::int32_t link;
+    std::int32_t depth;    // string depth from root
+    std::int32_t first_edge;
+    std::int32_t edge_count;
+};
+
+struct FlatEdge {
+    std::int32_t to;
+    unsigned char c;
+    unsigned char pad[3];
+};
+
+static const char INDEX_MAGIC[8] = {'L', 'A', 'B', '5', 'S', 'I', 'D', 'X'};
+static const std::uint32_t INDEX_VERSION = 1;
+
+static inline std::size_t alignUp8(std::size_t x) { return (x + 7) & ~std::size_t(7); }
+
+// Узлы, их таблицы переходов и концы рёбер можно держать в arena::Arena:
+// тогда при разрушении дерево ничего не обходит и не освобождает по одному.
+class SuffixTree {
+private:
+    arena::Arena *ar;              // nullptr — обычная куча
+    std::pmr::memory_resource *mr;
+    std::string text;
+    std::pmr::vector<Node> nodes;
+    int root;
+
+    int active_node;
+    int active_edge;
+    int active_length;
+
+    int remaining;
+    int *leaf_end;
+    int pos;
+    int last_new_node;
+
+    std::vector<int*> allocated_ends; // to delete later (not used with an arena)
+
+    int *newEnd(int value) {
+        return ar ? ar->make<int>(value) : new int(value);
+    }
+
+    inline int edgeLen(int idx) const {
+        return *(nodes[idx].end) - nodes[idx].start + 1;
+    }
+
+    int newNode(int start, int *endPtr) {
+        nodes.emplace_back(start, endPtr, mr);
+        nodes.back().link = -1;
+        // record endPtr only if it's not the shared leaf_end (to avoid duplicates)
+        if (!ar && endPtr != nullptr && endPtr != leaf_end) allocated_ends.push_back(endPtr);
+        return (int)nodes.size() - 1;
+    }
+
+    bool walkDown(int next) {
+        int elen = edgeLen(next);
+        if (active_length >= elen) {
+            active_edge += elen;
+            active_length -= elen;
+            active_node = next;
+            return true;
+        }
+        return false;
+    }
+
+    void extend(int idx) {
+        pos = idx;
+        *leaf_end = pos;
+        remaining++;
+        last_new_node = -1;
+        LAB_COUNT("lab5.extend");
+
+        while (remaining > 0) {
+            LAB_COUNT("lab5.extend_steps");
+            if (active_length == 0) active_edge = pos;
+            char a = text[active_edge];
+            auto it = nodes[active_node].next.find(a);
+            if (it == nodes[active_node].next.end()) {
+                int leaf = newNode(pos, leaf_end);
+                nodes[active_node].next[a] = leaf;
+                if (last_new_node != -1) {
+                    nodes[last_new_node].link = active_node;
+                    last_new_node = -1;
+                }
+            } else {
+                int next = it->second;
+                if (walkDown(next)) continue;
+                char cur = text[nodes[next].start + active_length];
+                if (cur == text[pos]) {
+                    active_length++;
+                    if (last_new_node != -1) {
+                        nodes[last_new_node].link = active_node;
+                        last_new_node = -1;
+                    }
+                    break;
+                }
+                LAB_COUNT("lab5.split");
+                int *split_end = newEnd(nodes[next].start + active_length - 1);
+                int split = newNode(nodes[next].start, split_end);
+                nodes[active_node].next[a] = split;
+                int leaf = newNode(pos, leaf_end);
+                nodes[split].next[text[pos]] = leaf;
+                nodes[split].next[cur] = next;
+                nodes[next].start += active_length;
+                if (last_new_node != -1) nodes[last_new_node].link = split;
+                last_new_node = split;
+            }
+
+            remaining--;
+            if (active_node == root && active_length > 0) {
+                active_length--;
+                active_edge = pos - remaining + 1;
+            } else if (nodes[active_node].link != -1) {
+                active_node = nodes[active_node].link;
+            } else {
+                active_node = root;
+            }
+        }
+    }
+
+    struct Frame {
+        int v;
+        int depth;
+        decltype(Node::next)::const_iterator it;
+    };
+
+    // Один итеративный post-order обход вместо трёх рекурсивных: на входах вида
+    // "aaaa..." глубина дерева линейна по длине текста и рекурсия переполняет стек.
+    // За проход заполняются example_s1/example_s2, ищется максимальная глубина
+    // общего узла и запоминаются позиции начала кандидатов этой глубины.
+    int markExamplesAndFindDeepest(int pos_dollar, int pos_hash, std::vector<int> &starts) {
+        int max_len = 0;
+        std::vector<Frame> stack;
+        stack.push_back({root, 0, nodes[root].next.cbegin()});
+
+        while (!stack.empty()) {
+            Frame &top = stack.back();
+            if (top.it != nodes[top.v].next.cend()) {
+                int to = top.it->second;
+                ++top.it;
+                int depth = top.depth + edgeLen(to);
+                stack.push_back({to, depth, nodes[to].next.cbegin()});
+                continue;
+            }
+
+            int v = top.v;
+            int depth = top.depth;
+            stack.pop_back();
+
+            if (nodes[v].next.empty()) {
+                int suffixIndex = (int)text.size() - depth;
+                if (suffixIndex >= 0 && suffixIndex < pos_dollar) {
+                    nodes[v].example_s1 = suffixIndex;
+                } else if (suffixIndex > pos_dollar && suffixIndex < pos_hash) {
+                    nodes[v].example_s2 = suffixIndex;
+                }
+            } else if (nodes[v].example_s1 != -1 && nodes[v].example_s2 != -1 && depth > 0) {
+                if (depth > max_len) {
+                    max_len = depth;
+                    starts.clear();
+                }
+                if (depth == max_len) starts.push_back(nodes[v].example_s1);
+            }
+
+            if (!stack.empty()) {
+                int p = stack.back().v;
+                if (nodes[p].example_s1 == -1) nodes[p].example_s1 = nodes[v].example_s1;
+                if (nodes[p].example_s2 == -1) nodes[p].example_s2 = nodes[v].example_s2;
+            }
+        }
+        return max_len;
+    }
+
+    SuffixTree(arena::Arena *a, std::pmr::memory_resource *m)
+        : ar(a), mr(m), nodes(m), root(-1), active_node(0), active_edge(0), active_length(0),
+          remaining(0), leaf_end(nullptr), pos(-1), last_new_node(-1) {}
+
+public:
+    SuffixTree(): SuffixTree(nullptr, std::pmr::new_delete_resource()) {}
+
+    // Всё в арене; она должна пережить дерево.
+    explicit SuffixTree(arena::Arena &a): SuffixTree(&a, &a) {}
+
+    SuffixTree(const SuffixTree&) = delete;
+    SuffixTree &operator=(const SuffixTree&) = delete;
+
+    void build(const std::string &s) {
+        text = s;
+        nodes.clear();
+        allocated_ends.clear();
+        leaf_end = newEnd(-1);
+        nodes.reserve((int)text.size() * 2 + 5);
+        root = newNode(-1, newEnd(-1));
+        nodes[root].link = -1;
+        active_node = root;
+        active_edge = 0;
+        active_length = 0;
+        remaining = 0;
+        last_new_node = -1;
+
+        for (size_t i = 0; i < text.size(); ++i) extend((int)i);
+    }
+
+    // Сохраняет дерево в плоском виде, пригодном для mmap (см. SuffixIndex).
+    void save(const std::string &path) const {
+        std::vector<int> order;
+        std::vector<int> flat_id(nodes.size(), -1);
+        order.reserve(nodes.size());
+        order.push_back(root);
+        flat_id[root] = 0;
+
+        std::vector<FlatNode> flat;
+        std::vector<FlatEdge> edges;
+        flat.reserve(nodes.size());
+        edges.reserve(nodes.size());
+        std::vector<std::pair<char,int>> kids;
+
+        for (size_t i = 0; i < order.size(); ++i) {
+            int v = order[i];
+            FlatNode fn;
+            fn.start = nodes[v].start;
+            fn.end = *(nodes[v].end);
+            fn.link = nodes[v].link;
+            fn.depth = 0;
+            fn.first_edge = (int)edges.size();
+            fn.edge_count = (int)nodes[v].next.size();
+
+            kids.assign(nodes[v].next.begin(), nodes[v].next.end());
+            std::sort(kids.begin(), kids.end(), [](const std::pair<char,int> &a, const std::pair<char,int> &b) {
+                return (unsigned char)a.first < (unsigned char)b.first;
+            });
+            for (auto &kv : kids) {
+                flat_id[kv.second] = (int)order.size();
+                order.push_back(kv.second);
+                edges.push_back({flat_id[kv.second], (unsigned char)kv.first, {0, 0, 0}});
+            }
+            flat.push_back(fn);
+        }
+
+        // глубины и суффиксные ссылки в новой нумерации; родитель всегда раньше ребёнка
+        for (size_t i = 0; i < flat.size(); ++i) {
+            for (int e = flat[i].first_edge; e < flat[i].first_edge + flat[i].edge_count; ++e) {
+                FlatNode &ch = flat[edges[e].to];
+                ch.depth = flat[i].depth + (ch.end - ch.start + 1);
+            }
+            flat[i].link = (flat[i].link == -1) ? 0 : flat_id[flat[i].link];
+        }
+
+        IndexHeader hdr;
+        std::memcpy(hdr.magic, INDEX_MAGIC, sizeof(hdr.magic));
+        hdr.version = INDEX_VERSION;
+        hdr.node_count = (std::uint32_t)flat.size();
+        hdr.text_len = text.size();
+        hdr.edge_count = edges.size();
+
+        std::ofstream out(path, std::ios::binary);
+        if (!out) throw std::runtime_error("cannot open index file for writing");
+        out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        out.write(text.data(), (std::streamsize)text.size());
+        static const char zeros[8] = {};
+        out.write(zeros, (std::streamsize)(alignUp8(text.size()) - text.size()));
+        out.write(reinterpret_cast<const char*>(flat.data()), (std::streamsize)(flat.size() * sizeof(FlatNode)));
+        out.write(reinterpret_cast<const char*>(edges.data()), (std::streamsize)(edges.size() * sizeof(FlatEdge)));
+        if (!out) throw std::runtime_error("failed to write index file");
+    }
+
+    std::pair<int, std::vector<std::string>> findLCSForTwoStrings(int pos_dollar, int pos_hash) {
+        std::vector<int> starts;
+        int max_len = markExamplesAndFindDeepest(pos_dollar, pos_hash, starts);
+
+        // каждый узел задаёт свою строку, поэтому сортируем позиции, а не копии подстрок
+        auto label = [&](int p) { return std::string_view(text).substr(p, max_len); };
+        std::sort(starts.begin(), starts.end(), [&](int a, int b) { return label(a) < label(b); });
+        starts.erase(std::unique(starts.begin(), starts.end(),
+                                 [&](int a, int b) { return label(a) == label(b); }),
+                     starts.end());
+
+        std::vector<std::string> out;
+        out.reserve(starts.size());
+        for (int p : starts) out.emplace_back(label(p));
+        return {max_len, out};
+    }
+
+    ~SuffixTree() {
+        if (ar) {
+            arena::abandon(nodes);
+            return;
+        }
+        if (leaf_end) delete leaf_end;
+        for (int *p : allocated_ends) delete p;
+        allocated_ends.clear();
+    }
+};
+
+// Индекс по фиксированной строке, отображённый в память. Запрос сканирует
+// вторую строку по суффиксным ссылкам (matching statistics) за O(|query|).
+class SuffixIndex {
+private:
+    void *base;
+    std::size_t mapped;
+    const IndexHeader *hdr;
+    const char *text;
+    const FlatNode *nodes;
+    const FlatEdge *edges;
+
+    int child(int v, unsigned char c) const {
+        const FlatEdge *b = edges + nodes[v].first_edge;
+        const FlatEdge *e = b + nodes[v].edge_count;
+        const FlatEdge *it = std::lower_bound(b, e, c, [](const FlatEdge &x, unsigned char ch) { return x.c < ch; });
+        return (it != e && it->c == c) ? it->to : -1;
+    }
+
+public:
+    explicit SuffixIndex(const std::string &path) : base(nullptr), mapped(0) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open index file for reading");
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || (std::size_t)st.st_size < sizeof(IndexHeader)) {
+            ::close(fd);
+            throw std::runtime_error("index file is truncated");
+        }
+        mapped = (std::size_t)st.st_size;
+        base = ::mmap(nullptr, mapped, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            base = nullptr;
+            throw std::runtime_error("cannot mmap index file");
+        }
+
+        const char *p = static_cast<const char*>(base);
+        hdr = reinterpret_cast<const IndexHeader*>(p);
+        std::size_t need = sizeof(IndexHeader) + alignUp8(hdr->text_len)
+                         + hdr->node_count * sizeof(FlatNode) + hdr->edge_count * sizeof(FlatEdge);
+        if (std::memcmp(hdr->magic, INDEX_MAGIC, sizeof(hdr->magic)) != 0 || hdr->version != INDEX_VERSION
+            || hdr->node_count == 0 || need != mapped) {
+            ::munmap(base, mapped);
+            base = nullptr;
+            throw std::runtime_error("bad index file");
+        }
+        p += sizeof(IndexHeader);
+        text = p;
+        p += alignUp8(hdr->text_len);
+        nodes = reinterpret_cast<const FlatNode*>(p);
+        p += hdr->node_count * sizeof(FlatNode);
+        edges = reinterpret_cast<const FlatEdge*>(p);
+    }
+
+    SuffixIndex(const SuffixIndex&) = delete;
+    SuffixIndex &operator=(const SuffixIndex&) = delete;
+
+    std::pair<int, std::vector<std::string>> findLCS(const std::string &q) const {
+        int v = 0;        // ближайший явный узел на пути совпадения
+        int len = 0;      // длина текущего совпадения q[i..j)
+        int i = 0;
+        int max_len = 0;
+        std::vector<int> starts;
+
+        for (int j = 0; j < (int)q.size(); ++j) {
+            unsigned char c = (unsigned char)q[j];
+            for (;;) {
+                bool ok;
+                if (len == nodes[v].depth) {
+                    int u = child(v, c);
+                    ok = (u != -1);
+                    if (ok) {
+                        ++len;
+                        if (len == nodes[u].depth) v = u;
+                    }
+                } else {
+                    int u = child(v, (unsigned char)q[i + nodes[v].depth]);
+                    ok = ((unsigned char)text[nodes[u].start + (len - nodes[v].depth)] == c);
+                    if (ok) {
+                        ++len;
+                        if (len == nodes[u].depth) v = u;
+                    }
+                }
+                if (ok) break;
+                if (len == 0) {
+                    i = j + 1;
+                    break;
+                }
+                // отбрасываем первый символ и спускаемся заново прыжками по рёбрам
+                --len;
+                ++i;
+                v = nodes[v].link;
+                while (len > nodes[v].depth) {
+                    int u = child(v, (unsigned char)q[i + nodes[v].depth]);
+                    if (nodes[u].depth > len) break;
+                    v = u;
+                }
+            }
+
+            if (len > max_len) {
+                max_len = len;
+                starts.clear();
+            }
+            if (len == max_len && len > 0) starts.push_back(i);
+        }
+
+        auto label = [&](int p) { return std::string_view(q).substr(p, max_len); };
+        std::sort(starts.begin(), starts.end(), [&](int a, int b) { return label(a) < label(b); });
+        starts.erase(std::unique(starts.begin(), starts.end(),
+                                 [&](int a, int b) { return label(a) == label(b); }),
+                     starts.end());
+
+        std::vector<std::string> out;
+        out.reserve(starts.size());
+        for (int p : starts) out.emplace_back(label(p));
+        return {max_len, out};
+    }
+
+    ~SuffixIndex() {
+        if (base) ::munmap(base, mapped);
+    }
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+// Вычисление dp[x] = x + min(dp[x-1], dp[x/2], dp[x/3]) для x из [from, to]
+// без проверок x % 2 и x % 3. Требует, чтобы dp/op были посчитаны для всех x < from.
+//
+// Делимость на 2 и 3 повторяется с периодом 6, поэтому цикл идёт группами
+// x = 6k .. 6k+5 с заранее известным набором кандидатов:
+//   6k   — dp[3k] (/2) и dp[2k] (/3);
+//   6k+1 — только -1;
+//   6k+2 — dp[3k+1] (/2);
+//   6k+3 — dp[2k+1] (/3);
+//   6k+4 — dp[3k+2] (/2);
+//   6k+5 — только -1.
+// Кандидаты /2 и /3 читаются двумя последовательными потоками, последовательной
+// остаётся только цепочка по x-1. Порядок выбора при равенстве тот же, что в
+// исходном цикле: -1, затем /2, затем /3.
+
+namespace dpk {
+
+// Общий проход для всех хранилищ dp. at(i) возвращает уже посчитанное dp[i]
+// (читаются только i <= to / 2 и i < x), v — dp[from - 1]; для каждого x из
+// [from, to] вызывается emit(x, dp[x], op[x]). Возвращает dp[to] (v, если
+// диапазон пуст). Так полные таблицы, компактные режимы и пересчёт блоков
+// пути используют одну развёртку.
+template <class At, class Emit>
+inline long long run(At at, long long v, int from, int to, Emit emit) {
+    // x с проверками делимости: края диапазона, не кратные шестёрке. v
+    // передаётся по значению: по ссылке компилятор держит его в памяти, раз
+    // emit пишет в long long по указателю.
+    auto scalarStep = [&](long long x, long long v) {
+        unsigned char o = 0;
+        if (x % 2 == 0 && at(x / 2) < v) {
+            v = at(x / 2);
+            o = 1;
+        }
+        if (x % 3 == 0 && at(x / 3) < v) {
+            v = at(x / 3);
+            o = 2;
+        }
+        v += x;
+        emit(x, v, o);
+        return v;
+    };
+    // кандидат c с операцией cop против x-1
+    auto step = [&](long long x, long long v, long long c, unsigned char cop) {
+        unsigned char o = 0;
+        if (c < v) {
+            v = c;
+            o = cop;
+        }
+        v += x;
+        emit(x, v, o);
+        return v;
+    };
+
+    long long x = from;
+    for (; x <= to && x % 6 != 0; ++x) v = scalarStep(x, v);
+    if (x > to) return v;
+
+    long long k = x / 6;
+    for (; 6 * k + 5 <= to; ++k) {
+        const long long b = 6 * k;
+
+        long long c = at(3 * k);
+        unsigned char cop = 1;
+        if (at(2 * k) < c) {
+            c = at(2 * k);
+            cop = 2;
+        }
+        v = step(b, v, c, cop);
+
+        v += b + 1;
+        emit(b + 1, v, 0);
+
+        v = step(b + 2, v, at(3 * k + 1), 1);
+        v = step(b + 3, v, at(2 * k + 1), 2);
+        v = step(b + 4, v, at(3 * k + 2), 1);
+
+        v += b + 5;
+        emit(b + 5, v, 0);
+    }
+
+    for (x = 6 * k; x <= to; ++x) v = scalarStep(x, v);
+    return v;
+}
+
+inline void fill(long long *dp, unsigned char *op, int from, int to) {
+    if (from < 2) {
+        dp[1] = 0;
+        op[1] = 0;
+        from = 2;
+    }
+    if (from > to) return;
+    run([dp](long long i) { return dp[i]; }, dp[from - 1], from, to,
+        [dp, op](long long x, long long v, unsigned char o) {
+            dp[x] = v;
+            op[x] = o;
+        });
+}
+
+} // namespace dpk
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "dp_kernel.hpp"
+#include "../common/fastio.hpp"
+#include "../common/instrument.hpp"
+
+// Режимы --packed/--checkpoint и таблицы --serve/--save-table. Ответ пишется
+// в переданный FastWriter в том же формате, что и у основного режима.
+
+// Выбор операций, упакованный по 2 бита на число (0 = -1, 1 = /2, 2 = /3).
+class PackedOps {
+private:
+    std::vector<std::uint8_t> bits;
+
+public:
+    explicit PackedOps(std::size_t n) : bits(n / 4 + 1, 0) {}
+
+    void set(std::size_t x, unsigned char op) {
+        bits[x >> 2] |= static_cast<std::uint8_t>(op << ((x & 3) * 2));
+    }
+
+    unsigned char get(std::size_t x) const {
+        return (bits[x >> 2] >> ((x & 3) * 2)) & 3;
+    }
+};
+
+inline void writeOp(FastWriter &out, unsigned char op) {
+    static const char *names[3] = {"-1 ", "/2 ", "/3 "};
+    out.write(names[op], 3);
+}
+
+inline int applyOp(int cur, unsigned char op) {
+    return op == 0 ? cur - 1 : (op == 1 ? cur / 2 : cur / 3);
+}
+
+// Компактные режимы. dp[x] нужен целиком только для x <= n/2 (к ним ведут /2 и /3),
+// выше хватает предыдущего значения. По индукции dp[x] < 4x, поэтому для x <= n/2
+// значения помещаются в uint32 при любом n, влезающем в int.
+//
+// packed:     op хранится для всех x по 2 бита, путь восстанавливается по ним;
+// checkpoint: op не хранится вовсе, в верхней половине запоминается каждое
+//             K-е значение dp, а при восстановлении пути блок из K значений
+//             пересчитывается от ближайшей контрольной точки.
+// Рекуррентность считает общий dpk::run, K — из [1, max(n, 1)].
+inline void solveCompact(int n, bool packed, int K, FastWriter &out) {
+    const int half = n / 2;
+    std::vector<std::uint32_t> low(half + 1, 0);
+    PackedOps ops(packed ? n + 1 : 0);
+    std::vector<long long> checkpoints;
+    if (!packed) checkpoints.reserve((n - half) / K + 2);
+
+    std::uint32_t *lo = low.data();
+    auto lowAt = [lo](long long i) -> long long { return lo[i]; };
+    // контрольные точки — dp[half], dp[half + K], ...; при half <= 1 первая — dp[1] = 0
+    long long nextCheckpoint = half >= 2 ? half : static_cast<long long>(half) + K;
+    if (!packed && half <= 1) checkpoints.push_back(0);
+    long long prev; // dp[n]
+    {
+        LAB_PHASE("build");
+        prev = dpk::run(lowAt, 0, 2, n, [&](long long x, long long v, unsigned char o) {
+            if (x <= half) lo[x] = static_cast<std::uint32_t>(v);
+            if (packed) {
+                ops.set(x, o);
+            } else if (x == nextCheckpoint) {
+                checkpoints.push_back(v);
+                nextCheckpoint += K;
+            }
+        });
+    }
+
+    // в checkpoint сюда же входит пересчёт блоков пути
+    LAB_PHASE("output");
+    out.writeInt(prev);
+    out.write("\n", 1);
+
+    if (packed) {
+        for (int cur = n; cur > 1;) {
+            unsigned char op = ops.get(cur);
+            writeOp(out, op);
+            cur = applyOp(cur, op);
+        }
+        out.write("\n", 1);
+        return;
+    }
+
+    // блок b покрывает x из (half + b*K, half + (b+1)*K], block[i] = dp[half + b*K + i]
+    std::vector<long long> block(K + 1);
+    int loaded = -1;
+    auto dpAt = [&](int x) -> long long {
+        if (x <= half) return low[x];
+        int b = (x - half - 1) / K;
+        int base = half + b * K;
+        if (b != loaded) {
+            block[0] = checkpoints[b];
+            long long *blk = block.data();
+            const int last = static_cast<int>(std::min<long long>(static_cast<long long>(base) + K, n));
+            dpk::run(lowAt, block[0], base + 1, last,
+                     [blk, base](long long y, long long v, unsigned char) { blk[y - base] = v; });
+            loaded = b;
+        }
+        return block[x - base];
+    };
+
+    for (int cur = n; cur > 1;) {
+        long long bestVal = dpAt(cur - 1);
+        unsigned char op = 0;
+        if (cur % 2 == 0 && low[cur / 2] < bestVal) {
+            bestVal = low[cur / 2];
+            op = 1;
+        }
+        if (cur % 3 == 0 && low[cur / 3] < bestVal) {
+            op = 2;
+        }
+        writeOp(out, op);
+        cur = applyOp(cur, op);
+    }
+    out.write("\n", 1);
+}
+
+struct TableHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::int32_t limit;
+};
+
+static const char TABLE_MAGIC[8] = {'L', 'A', 'B', '6', 'D', 'P', 'T', '\0'};
+static const std::uint32_t TABLE_VERSION = 1;
+
+// Общие таблицы dp/op для потока запросов. dp[x] не зависит от n, поэтому
+// таблицы только дорастают до максимального запрошенного n. Начальный префикс
+// может быть взят из заранее посчитанного файла, отображённого в память;
+// при выходе за его пределы таблицы копируются в память процесса.
+class DpTable {
+private:
+    std::vector<long long> dpOwn;
+    std::vector<unsigned char> opOwn;
+    const long long *dp;
+    const unsigned char *op;
+    int limit;
+
+    void *mapped;
+    std::size_t mappedLen;
+
+    void unmap() {
+        if (mapped) ::munmap(mapped, mappedLen);
+        mapped = nullptr;
+    }
+
+public:
+    DpTable() : dpOwn(2, 0), opOwn(2, 0), dp(nullptr), op(nullptr), limit(1), mapped(nullptr), mappedLen(0) {
+        dp = dpOwn.data();
+        op = opOwn.data();
+    }
+
+    DpTable(const DpTable&) = delete;
+    DpTable &operator=(const DpTable&) = delete;
+
+    int size() const { return limit; }
+
+    void grow(int n) {
+        if (n <= limit) return;
+        LAB_PHASE("build");
+        if (mapped) {
+            dpOwn.assign(dp, dp + limit + 1);
+            opOwn.assign(op, op + limit + 1);
+            unmap();
+        }
+        std::size_t cap = std::max<std::size_t>(n + 1, std::min<std::size_t>(2 * dpOwn.size(), 0x7fffffff));
+        dpOwn.reserve(cap);
+        opOwn.reserve(cap);
+        dpOwn.resize(n + 1);
+        opOwn.resize(n + 1);
+        dpk::fill(dpOwn.data(), opOwn.data(), limit + 1, n);
+        dp = dpOwn.data();
+        op = opOwn.data();
+        limit = n;
+    }
+
+    // на n < 1 — "-1" и пустая строка, чтобы ответы сопоставлялись запросам по номеру строки
+    void answer(int n, FastWriter &out) {
+        if (n < 1) {
+            out.write("-1\n\n", 4);
+            return;
+        }
+        grow(n);
+        LAB_PHASE("output");
+        out.writeInt(dp[n]);
+        out.write("\n", 1);
+        for (int cur = n; cur > 1; cur = applyOp(cur, op[cur])) writeOp(out, op[cur]);
+        out.write("\n", 1);
+    }
+
+    void save(const std::string &path) const {
+        TableHeader hdr;
+        std::memcpy(hdr.magic, TABLE_MAGIC, sizeof(hdr.magic));
+        hdr.version = TABLE_VERSION;
+        hdr.limit = limit;
+        std::ofstream file(path, std::ios::binary);
+        if (!file) throw std::runtime_error("cannot open table file for writing");
+        file.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        file.write(reinterpret_cast<const char*>(dp), (std::streamsize)((limit + 1) * sizeof(long long)));
+        file.write(reinterpret_cast<const char*>(op), limit + 1);
+        if (!file) throw std::runtime_error("failed to write table file");
+    }
+
+    void load(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open table file for reading");
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || (std::size_t)st.st_size < sizeof(TableHeader)) {
+            ::close(fd);
+            throw std::runtime_error("table file is truncated");
+        }
+        std::size_t len = (std::size_t)st.st_size;
+        void *base = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) throw std::runtime_error("cannot mmap table file");
+
+        const TableHeader *hdr = static_cast<const TableHeader*>(base);
+        std::size_t entries = (hdr->limit >= 1) ? (std::size_t)hdr->limit + 1 : 0;
+        if (std::memcmp(hdr->magic, TABLE_MAGIC, sizeof(hdr->magic)) != 0 || hdr->version != TABLE_VERSION
+            || entries == 0 || len != sizeof(TableHeader) + entries * (sizeof(long long) + 1)) {
+            ::munmap(base, len);
+            throw std::runtime_error("bad table file");
+        }
+        unmap();
+        mapped = base;
+        mappedLen = len;
+        limit = hdr->limit;
+        dp = reinterpret_cast<const long long*>(static_cast<const char*>(base) + sizeof(TableHeader));
+        op = reinterpret_cast<const unsigned char*>(dp + entries);
+        dpOwn.clear();
+        opOwn.clear();
+    }
+
+    ~DpTable() { unmap(); }
+};
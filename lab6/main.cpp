@@ -1,54 +1,75 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <stdexcept>
 
+#include "dp_kernel.hpp"
+#include "dp_solver.hpp"
+#include "../common/fastio.hpp"
+#include "../common/instrument.hpp"
 
-int main() {
-    std::ios::sync_with_stdio(false);
-    std::cin.tie(nullptr);
+
+// Режимы:
+//   main                        — как раньше, полные таблицы dp и op;
+//   main --packed               — op по 2 бита, путь пишется потоком;
+//   main --checkpoint [K]       — op не хранится, путь пересчитывается блоками по K (по умолчанию 4096);
+//   main --serve [FILE]         — поток запросов n, общие растущие таблицы (FILE — готовая таблица);
+//                                 на каждый запрос две строки, на n < 1 — "-1" и пустая строка;
+//   main --save-table N FILE    — посчитать таблицы до N и сохранить для --serve.
+int main(int argc, char **argv) {
+    LAB_PHASE("parse");
+    FastReader in;
+
+    std::string mode = (argc >= 2) ? argv[1] : "";
+    if (mode == "--packed" || mode == "--checkpoint") {
+        long long K = (argc >= 3) ? std::strtoll(argv[2], nullptr, 10) : 4096;
+        int n;
+        if (!in.readInt(n)) return 0;
+        // блок длиннее n не нужен, а K + 1 должно помещаться в int
+        K = std::clamp<long long>(K, 1, std::max(n, 1));
+        FastWriter out;
+        solveCompact(n, mode == "--packed", static_cast<int>(K), out);
+        return 0;
+    }
+    if (mode == "--serve" || mode == "--save-table") {
+        try {
+            DpTable table;
+            if (mode == "--save-table") {
+                if (argc < 4) throw std::runtime_error("usage: --save-table N FILE");
+                table.grow(std::atoi(argv[2]));
+                table.save(argv[3]);
+                return 0;
+            }
+            if (argc >= 3) table.load(argv[2]);
+            FastWriter out;
+            in.tie(&out); // ответы уходят, пока запросы ещё идут
+            int n;
+            while (in.readInt(n)) table.answer(n, out);
+        } catch (const std::exception &e) {
+            std::cerr << "ERROR: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
 
     int n;
-    if (!(std::cin >> n)) return 0;
+    if (!in.readInt(n)) return 0;
 
     std::vector<long long> dp(n + 1);
     std::vector<unsigned char> op(n + 1, 0); // 0 = -1, 1 = /2, 2 = /3
 
-    dp[1] = 0;
-    for (int x = 2; x <= n; ++x) {
-        long long bestVal = dp[x - 1];
-        unsigned char bestOp = 0;
-
-        if (x % 2 == 0 && dp[x / 2] < bestVal) {
-            bestVal = dp[x / 2];
-            bestOp = 1;
-        }
-        if (x % 3 == 0 && dp[x / 3] < bestVal) {
-            bestVal = dp[x / 3];
-            bestOp = 2;
-        }
-
-        dp[x] = static_cast<long long>(x) + bestVal;
-        op[x] = bestOp;
+    {
+        LAB_PHASE("build");
+        dpk::fill(dp.data(), op.data(), 1, n);
     }
 
-    std::cout << dp[n] << '\n';
-
-    std::string result;
-    result.reserve(n * 3);
-    int cur = n;
-
-    while (cur > 1) {
-        if (op[cur] == 0) {
-            result += "-1 ";
-            cur -= 1;
-        } else if (op[cur] == 1) {
-            result += "/2 ";
-            cur /= 2;
-        } else {
-            result += "/3 ";
-            cur /= 3;
-        }
-    }
-    std::cout << result << '\n';
+    LAB_PHASE("output");
+    FastWriter out;
+    out.writeInt(dp[n]);
+    out.put('\n');
+    for (int cur = n; cur > 1; cur = applyOp(cur, op[cur])) writeOp(out, op[cur]);
+    out.put('\n');
     return 0;
 }
@@ -2,35 +2,55 @@
 #include <vector>
 #include <string>
 #include <chrono>
+#include <algorithm>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "dp_kernel.hpp"
+
+static std::uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static void scalarLoop(std::vector<long long> &dp, std::vector<unsigned char> &op, int n) {
+    dp[1] = 0;
+    for (int x = 2; x <= n; ++x) {
+        long long bestVal = dp[x - 1];
+        unsigned char bestOp = 0;
+        if (x % 2 == 0 && dp[x / 2] < bestVal) {
+            bestVal = dp[x / 2];
+            bestOp = 1;
+        }
+        if (x % 3 == 0 && dp[x / 3] < bestVal) {
+            bestVal = dp[x / 3];
+            bestOp = 2;
+        }
+        dp[x] = static_cast<long long>(x) + bestVal;
+        op[x] = bestOp;
+    }
+}
 
 int main() {
-    std::vector<int> tests = {100000, 200000, 500000, 1000000, 2000000, 5000000, 10000000};
+    std::vector<int> tests = {100000, 200000, 500000, 1000000, 2000000, 5000000, 10000000,
+                              100000000};
 
-    std::cout << "n,time_ms,ops_len,dp_n" << '\n';
+    std::cout << "n,time_ms,ops_len,dp_n,blocked_ms,scalar_cpe,blocked_cpe,same" << '\n';
 
     for (int n : tests) {
         try {
             std::vector<long long> dp(n + 1);
             std::vector<unsigned char> op(n + 1, 0);
-            dp[1] = 0;
 
             auto t0 = std::chrono::high_resolution_clock::now();
-
-            for (int x = 2; x <= n; ++x) {
-                long long bestVal = dp[x - 1];
-                unsigned char bestOp = 0;
-                if (x % 2 == 0 && dp[x / 2] < bestVal) {
-                    bestVal = dp[x / 2];
-                    bestOp = 1;
-                }
-                if (x % 3 == 0 && dp[x / 3] < bestVal) {
-                    bestVal = dp[x / 3];
-                    bestOp = 2;
-                }
-                dp[x] = static_cast<long long>(x) + bestVal;
-                op[x] = bestOp;
-            }
-
+            std::uint64_t c0 = cycles();
+            scalarLoop(dp, op, n);
+            std::uint64_t c1 = cycles();
             auto t1 = std::chrono::high_resolution_clock::now();
             long long time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
 
@@ -49,7 +69,25 @@ int main() {
                 ops_len = -1; // маркер: не вычислено
             }
 
-            std::cout << n << ',' << time_ms << ',' << ops_len << ',' << dp[n] << '\n';
+            long long dp_n = dp[n];
+
+            // ядро пишет в свои буферы, заполненные невозможными значениями:
+            // пропущенный индекс не совпадёт с эталоном
+            std::vector<long long> dp2(n + 1, -1);
+            std::vector<unsigned char> op2(n + 1, 3);
+            auto t2 = std::chrono::high_resolution_clock::now();
+            std::uint64_t c2 = cycles();
+            dpk::fill(dp2.data(), op2.data(), 1, n);
+            std::uint64_t c3 = cycles();
+            auto t3 = std::chrono::high_resolution_clock::now();
+            long long blocked_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t3 - t2).count();
+
+            bool same = std::equal(dp.begin() + 1, dp.end(), dp2.begin() + 1) &&
+                        std::equal(op.begin() + 1, op.end(), op2.begin() + 1);
+
+            std::cout << n << ',' << time_ms << ',' << ops_len << ',' << dp_n << ','
+                      << blocked_ms << ',' << double(c1 - c0) / (n - 1) << ','
+                      << double(c3 - c2) / (n - 1) << ',' << (same ? "yes" : "NO") << '\n';
 
         } catch (const std::bad_alloc &e) {
             std::cerr << "Memory allocation failed for n=" << n << '\n';
@@ -57,4 +95,4 @@ int main() {
     }
 
     return 0;
-}
\ No newline at end of file
+}
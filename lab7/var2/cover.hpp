@@ -0,0 +1,299 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#include "../../common/fastio.hpp"
+
+struct Seg {
+    int L, R, idx;
+};
+
+// Устойчивая поразрядная сортировка по L (LSD, 4 прохода по 8 бит).
+// Знаковый бит инвертируется, чтобы отрицательные координаты шли раньше.
+inline void radix_sort_by_L(std::vector<Seg>& a) {
+    std::vector<Seg> tmp(a.size());
+    std::size_t cnt[256];
+    for (int shift = 0; shift < 32; shift += 8) {
+        std::fill(cnt, cnt + 256, 0);
+        for (const Seg& s : a)
+            ++cnt[((static_cast<std::uint32_t>(s.L) ^ 0x80000000u) >> shift) & 255];
+        // все ключи в одной корзине — проход ничего не меняет
+        if (*std::max_element(cnt, cnt + 256) == a.size()) continue;
+        std::size_t sum = 0;
+        for (int d = 0; d < 256; ++d) {
+            std::size_t c = cnt[d];
+            cnt[d] = sum;
+            sum += c;
+        }
+        for (const Seg& s : a)
+            tmp[cnt[((static_cast<std::uint32_t>(s.L) ^ 0x80000000u) >> shift) & 255]++] = s;
+        a.swap(tmp);
+    }
+}
+
+// Жадное покрытие [0, M] по отсортированным по L отрезкам. Возвращает false,
+// если покрыть нельзя, иначе кладёт выбранные отрезки в res.
+inline bool greedy_cover_sorted(const std::vector<Seg>& segs, int M, std::vector<Seg>& res) {
+    const int N = static_cast<int>(segs.size());
+    int cur = 0;
+    int i = 0;
+    int bestR = -1; // Будем жадно брать тот отрезок, который позже всех кончается
+    int bestIdx = -1;
+
+    while (cur < M) {
+        bool found = false;
+        while (i < N && segs[i].L <= cur) {
+            if (segs[i].R > bestR) {
+                bestR = segs[i].R;
+                bestIdx = i;
+                found = true;
+            }
+            ++i;
+        }
+        if (!found) return false;
+        res.push_back(segs[bestIdx]);
+        cur = bestR;
+    }
+    return true;
+}
+
+// Раскладывает выбранные отрезки в порядке исходных индексов без сортировки:
+// индексы отмечаются в битовой карте, позиция отрезка — число отметок до него.
+inline std::vector<Seg> order_by_idx(const std::vector<Seg>& chosen, int N) {
+    std::vector<std::uint64_t> bits((static_cast<std::size_t>(N) + 63) / 64, 0);
+    for (const Seg& s : chosen) bits[s.idx >> 6] |= std::uint64_t(1) << (s.idx & 63);
+
+    std::vector<std::uint32_t> before(bits.size());
+    std::uint32_t acc = 0;
+    for (std::size_t w = 0; w < bits.size(); ++w) {
+        before[w] = acc;
+        acc += static_cast<std::uint32_t>(__builtin_popcountll(bits[w]));
+    }
+
+    std::vector<Seg> out(chosen.size());
+    for (const Seg& s : chosen) {
+        std::uint64_t low = bits[s.idx >> 6] & ((std::uint64_t(1) << (s.idx & 63)) - 1);
+        out[before[s.idx >> 6] + __builtin_popcountll(low)] = s;
+    }
+    return out;
+}
+
+// Индекс для многих запросов «минимум отрезков, покрывающих [a, b]» над одним
+// набором. После первого шага текущая граница всегда равна чьему-то R, поэтому
+// переходы строятся на сжатых различных значениях R: next[i] — индекс
+// max{R : L <= Rvals[i]}, поверх него двоичные подъёмы up[k][i] = next^(2^k)(i).
+// Запрос — O(log N), восстановление списка — O(ответа).
+class CoverIndex {
+private:
+    std::vector<int> Ls;        // левые концы по возрастанию
+    std::vector<int> bestRid;   // для префикса Ls[0..p] — индекс лучшего R в Rvals
+    std::vector<int> bestSeg;   // и номер отрезка, на котором он достигается
+    std::vector<int> Rvals;     // различные R по возрастанию
+    std::vector<std::vector<int>> up;
+    std::vector<Seg> segs;      // в порядке Ls
+
+    // индекс в Rvals для max{R : L <= x}, -1 если таких отрезков нет
+    int reach(int x) const {
+        int p = static_cast<int>(std::upper_bound(Ls.begin(), Ls.end(), x) - Ls.begin()) - 1;
+        return p < 0 ? -1 : bestRid[p];
+    }
+
+    int reachSeg(int x) const {
+        int p = static_cast<int>(std::upper_bound(Ls.begin(), Ls.end(), x) - Ls.begin()) - 1;
+        return bestSeg[p];
+    }
+
+public:
+    explicit CoverIndex(std::vector<Seg> input) : segs(std::move(input)) {
+        radix_sort_by_L(segs);
+        const int n = static_cast<int>(segs.size());
+
+        Rvals.resize(n);
+        for (int i = 0; i < n; ++i) Rvals[i] = segs[i].R;
+        std::sort(Rvals.begin(), Rvals.end());
+        Rvals.erase(std::unique(Rvals.begin(), Rvals.end()), Rvals.end());
+
+        Ls.resize(n);
+        bestRid.resize(n);
+        bestSeg.resize(n);
+        int bestR = 0, best = -1;
+        for (int i = 0; i < n; ++i) {
+            Ls[i] = segs[i].L;
+            // строгое сравнение — как в жадном проходе: среди равных R берётся первый по L
+            if (best == -1 || segs[i].R > bestR) {
+                bestR = segs[i].R;
+                best = i;
+            }
+            bestRid[i] = static_cast<int>(std::lower_bound(Rvals.begin(), Rvals.end(), bestR) - Rvals.begin());
+            bestSeg[i] = best;
+        }
+
+        const int K = static_cast<int>(Rvals.size());
+        int levels = 1;
+        while ((1 << levels) < K) ++levels;
+        up.assign(levels, std::vector<int>(K));
+        for (int i = 0; i < K; ++i) {
+            int nx = reach(Rvals[i]);
+            up[0][i] = (nx > i) ? nx : i; // нет продвижения — неподвижная точка
+        }
+        for (int k = 1; k < levels; ++k)
+            for (int i = 0; i < K; ++i) up[k][i] = up[k - 1][up[k - 1][i]];
+    }
+
+    // Минимальное число отрезков, покрывающих [a, b], или -1.
+    // Если path задан, туда кладутся выбранные отрезки в порядке выбора.
+    int query(int a, int b, std::vector<Seg>* path = nullptr) const {
+        if (path) path->clear();
+        if (b <= a) return 0;
+        int x = reach(a);
+        if (x < 0 || Rvals[x] <= a) return -1;
+        int cnt = 1;
+        if (Rvals[x] < b) {
+            for (int k = static_cast<int>(up.size()) - 1; k >= 0; --k) {
+                if (Rvals[up[k][x]] < b) {
+                    x = up[k][x];
+                    cnt += 1 << k;
+                }
+            }
+            int nx = up[0][x];
+            if (nx == x) return -1;
+            ++cnt;
+        }
+        if (path) {
+            for (int cur = a; cur < b;) {
+                const Seg& s = segs[reachSeg(cur)];
+                path->push_back(s);
+                cur = s.R;
+            }
+        }
+        return cnt;
+    }
+};
+
+// Изменяемый набор отрезков: декартово дерево по ключу (L, idx), в каждой
+// вершине — отрезок поддерева с наибольшим R (при равенстве — с меньшим ключом,
+// как в жадном проходе). Вставка и удаление — O(log N), «лучший отрезок с
+// L <= x» — O(log N), поэтому жадное покрытие [0, M] стоит O(k log N).
+class DynamicCover {
+private:
+    struct Node {
+        Seg seg;
+        std::uint32_t prio;
+        int left, right;
+        int best; // вершина с лучшим отрезком в поддереве
+    };
+
+    std::vector<Node> pool;
+    std::vector<int> freeList;
+    int root;
+    std::mt19937 rng;
+
+    static bool less(const Seg& a, const Seg& b) {
+        return a.L != b.L ? a.L < b.L : a.idx < b.idx;
+    }
+
+    // лучший из двух, a левее b по ключу
+    int pick(int a, int b) const {
+        if (a == -1) return b;
+        if (b == -1) return a;
+        return pool[b].seg.R > pool[a].seg.R ? b : a;
+    }
+
+    int bestOf(int v) const { return v == -1 ? -1 : pool[v].best; }
+
+    void pull(int v) {
+        pool[v].best = pick(pick(bestOf(pool[v].left), v), bestOf(pool[v].right));
+    }
+
+    // l — ключи меньше key, r — остальные
+    void split(int v, const Seg& key, int& l, int& r) {
+        if (v == -1) {
+            l = r = -1;
+            return;
+        }
+        if (less(pool[v].seg, key)) {
+            split(pool[v].right, key, pool[v].right, r);
+            l = v;
+        } else {
+            split(pool[v].left, key, l, pool[v].left);
+            r = v;
+        }
+        pull(v);
+    }
+
+    int merge(int a, int b) {
+        if (a == -1) return b;
+        if (b == -1) return a;
+        if (pool[a].prio > pool[b].prio) {
+            pool[a].right = merge(pool[a].right, b);
+            pull(a);
+            return a;
+        }
+        pool[b].left = merge(a, pool[b].left);
+        pull(b);
+        return b;
+    }
+
+    // вершина с лучшим отрезком среди L <= x, -1 если таких нет
+    int bestUpTo(int x) const {
+        int res = -1;
+        for (int v = root; v != -1;) {
+            if (pool[v].seg.L <= x) {
+                res = pick(pick(res, bestOf(pool[v].left)), v);
+                v = pool[v].right;
+            } else {
+                v = pool[v].left;
+            }
+        }
+        return res;
+    }
+
+public:
+    DynamicCover() : root(-1), rng(12345) {}
+
+    void insert(const Seg& s) {
+        int v;
+        if (!freeList.empty()) {
+            v = freeList.back();
+            freeList.pop_back();
+        } else {
+            v = static_cast<int>(pool.size());
+            pool.emplace_back();
+        }
+        pool[v] = {s, static_cast<std::uint32_t>(rng()), -1, -1, v};
+        int l, r;
+        split(root, s, l, r);
+        root = merge(merge(l, v), r);
+    }
+
+    // удаляет отрезок с данными L и idx; false, если его нет
+    bool erase(const Seg& s) {
+        int l, mid, r;
+        split(root, s, l, r);
+        Seg next = s;
+        ++next.idx;
+        split(r, next, mid, r);
+        bool found = (mid != -1);
+        if (found) freeList.push_back(mid);
+        root = merge(l, r);
+        return found;
+    }
+
+    // Жадное покрытие [0, M] по текущему набору, семантика та же, что у
+    // greedy_cover_sorted.
+    bool cover(int M, std::vector<Seg>& res) const {
+        res.clear();
+        int cur = 0;
+        int bestR = -1;
+        while (cur < M) {
+            int v = bestUpTo(cur);
+            if (v == -1 || pool[v].seg.R <= bestR) return false;
+            res.push_back(pool[v].seg);
+            bestR = cur = pool[v].seg.R;
+        }
+        return true;
+    }
+};
@@ -1,26 +1,208 @@
-#include <iostream>
 #include <vector>
 #include <algorithm>
+#include <string>
+#include <unordered_map>
 
-struct Seg {
-    int L, R, idx;
-};
+#include "cover.hpp"
+#include "../../common/instrument.hpp"
+
+// Поразрядная сортировка, блочное чтение и вывод через битовую карту индексов.
+static int solve_fast() {
+    FastReader in;
+    FastWriter out;
 
-int main() {
     int N;
-    std::cin >> N;
+    if (!in.readInt(N)) return 0;
     std::vector<Seg> segs(N);
     for (int i = 0; i < N; ++i) {
-        std::cin >> segs[i].L >> segs[i].R;
+        in.readInt(segs[i].L);
+        in.readInt(segs[i].R);
         segs[i].idx = i;
     }
+    int M = 0;
+    in.readInt(M);
 
-    int M;
-    std::cin >> M;
+    {
+        LAB_PHASE("build");
+        radix_sort_by_L(segs);
+    }
 
-    std::sort(segs.begin(), segs.end(), [](auto& a, auto& b) {
-        return a.L < b.L;
-    });
+    std::vector<Seg> res;
+    bool covered = [&] {
+        LAB_PHASE("query");
+        return greedy_cover_sorted(segs, M, res);
+    }();
+    LAB_PHASE("output");
+    if (!covered) {
+        out.writeInt(0);
+        out.put('\n');
+        return 0;
+    }
+
+    out.writeInt(static_cast<long long>(res.size()));
+    out.put('\n');
+    for (const Seg& s : order_by_idx(res, N)) {
+        out.writeInt(s.L);
+        out.put(' ');
+        out.writeInt(s.R);
+        out.put('\n');
+    }
+    return 0;
+}
+
+// Много запросов над одним набором: после отрезков идёт Q и Q пар «a b».
+// На каждый запрос — минимальное число отрезков, покрывающих [a, b] (-1, если
+// нельзя), а с --list ещё и сами отрезки в порядке исходных индексов.
+static int solve_queries(bool list) {
+    FastReader in;
+    FastWriter out;
+
+    int N;
+    if (!in.readInt(N)) return 0;
+    std::vector<Seg> segs(N);
+    for (int i = 0; i < N; ++i) {
+        in.readInt(segs[i].L);
+        in.readInt(segs[i].R);
+        segs[i].idx = i;
+    }
+    CoverIndex index = [&] {
+        LAB_PHASE("build");
+        return CoverIndex(std::move(segs));
+    }();
+
+    int Q = 0;
+    in.readInt(Q);
+    std::vector<Seg> path;
+    for (int q = 0; q < Q; ++q) {
+        int a = 0, b = 0;
+        in.readInt(a);
+        in.readInt(b);
+        int cnt = [&] {
+            LAB_PHASE("query");
+            return index.query(a, b, list ? &path : nullptr);
+        }();
+        LAB_PHASE("output");
+        out.writeInt(cnt);
+        out.put('\n');
+        if (list && cnt > 0) {
+            std::sort(path.begin(), path.end(), [](const Seg& x, const Seg& y) { return x.idx < y.idx; });
+            for (const Seg& s : path) {
+                out.writeInt(s.L);
+                out.put(' ');
+                out.writeInt(s.R);
+                out.put('\n');
+            }
+        }
+    }
+    return 0;
+}
+
+// Изменяемый набор: после N отрезков и M идут операции до конца ввода:
+// «+ L R» — добавить отрезок (получает следующий номер, исходные — 0..N-1),
+// «- i» — удалить отрезок с номером i, «?» — вывести покрытие [0, M] текущим
+// набором в формате основного режима.
+// Живые отрезки хранятся по номеру в хеш-таблице, удалённые из неё уходят, так
+// что память зависит от числа живых отрезков, а не от длины потока операций.
+// Ответ из k отрезков упорядочивается по номеру сортировкой за O(k log k).
+static int solve_dynamic() {
+    FastReader in;
+    FastWriter out;
+
+    int N;
+    if (!in.readInt(N)) return 0;
+    DynamicCover set;
+    std::unordered_map<int, Seg> live;
+    live.reserve(N);
+    {
+        LAB_PHASE("build");
+        for (int i = 0; i < N; ++i) {
+            Seg s;
+            in.readInt(s.L);
+            in.readInt(s.R);
+            s.idx = i;
+            live.emplace(i, s);
+            set.insert(s);
+        }
+    }
+    int M = 0;
+    in.readInt(M);
+    int nextIdx = N;
+
+    std::vector<Seg> res;
+    for (int c = in.readChar(); c != -1; c = in.readChar()) {
+        if (c == '+') {
+            Seg s;
+            in.readInt(s.L);
+            in.readInt(s.R);
+            s.idx = nextIdx++;
+            LAB_PHASE("build");
+            live.emplace(s.idx, s);
+            set.insert(s);
+        } else if (c == '-') {
+            int i = -1;
+            in.readInt(i);
+            auto it = live.find(i);
+            if (it != live.end()) {
+                LAB_PHASE("build");
+                set.erase(it->second);
+                live.erase(it);
+            }
+        } else if (c == '?') {
+            bool covered = [&] {
+                LAB_PHASE("query");
+                return set.cover(M, res);
+            }();
+            LAB_PHASE("output");
+            if (!covered) {
+                out.writeInt(0);
+                out.put('\n');
+                continue;
+            }
+            std::sort(res.begin(), res.end(), [](const Seg& a, const Seg& b) { return a.idx < b.idx; });
+            out.writeInt(static_cast<long long>(res.size()));
+            out.put('\n');
+            for (const Seg& s : res) {
+                out.writeInt(s.L);
+                out.put(' ');
+                out.writeInt(s.R);
+                out.put('\n');
+            }
+        }
+    }
+    return 0;
+}
+
+// main --fast            — режим для больших N, вывод тот же;
+// main --queries [--list] — много запросов покрытия над одним набором;
+// main --dynamic         — вставки и удаления отрезков с пересчётом покрытия.
+int main(int argc, char** argv) {
+    LAB_PHASE("parse");
+    if (argc >= 2 && std::string(argv[1]) == "--fast") return solve_fast();
+    if (argc >= 2 && std::string(argv[1]) == "--dynamic") return solve_dynamic();
+    if (argc >= 2 && std::string(argv[1]) == "--queries")
+        return solve_queries(argc >= 3 && std::string(argv[2]) == "--list");
+
+    FastReader in;
+    FastWriter out;
+
+    int N = 0;
+    in.readInt(N);
+    std::vector<Seg> segs(N);
+    for (int i = 0; i < N; ++i) {
+        in.readInt(segs[i].L);
+        in.readInt(segs[i].R);
+        segs[i].idx = i;
+    }
+
+    int M = 0;
+    in.readInt(M);
+
+    {
+        LAB_PHASE("build");
+        std::sort(segs.begin(), segs.end(), [](auto& a, auto& b) {
+            return a.L < b.L;
+        });
+    }
 
     std::vector<Seg> res;
     int cur = 0;
@@ -28,31 +210,40 @@ int main() {
     int bestR = -1; // Будем жадно брать тот отрезок, который позже всех кончается
     int bestIdx = -1;
 
-    while (cur < M) {
-        bool found = false;
-        while (i < N && segs[i].L <= cur) {
-            if (segs[i].R > bestR) {
-                bestR = segs[i].R;
-                bestIdx = i;
-                found = true;
+    {
+        LAB_PHASE("query");
+        while (cur < M) {
+            bool found = false;
+            while (i < N && segs[i].L <= cur) {
+                if (segs[i].R > bestR) {
+                    bestR = segs[i].R;
+                    bestIdx = i;
+                    found = true;
+                }
+                ++i;
             }
-            ++i;
-        }
 
-        if (!found) {
-            std::cout << 0 << "\n";
-            return 0;
-        }
+            if (!found) {
+                out.write("0\n");
+                return 0;
+            }
 
-        res.push_back(segs[bestIdx]);
-        cur = bestR;
+            res.push_back(segs[bestIdx]);
+            cur = bestR;
+        }
     }
 
+    LAB_PHASE("output");
     std::sort(res.begin(), res.end(), [](auto& a, auto& b) {
         return a.idx < b.idx;
     });
 
-    std::cout << res.size() << "\n";
-    for (auto& s : res)
-        std::cout << s.L << " " << s.R << "\n";
+    out.writeInt(res.size());
+    out.put('\n');
+    for (auto& s : res) {
+        out.writeInt(s.L);
+        out.put(' ');
+        out.writeInt(s.R);
+        out.put('\n');
+    }
 }
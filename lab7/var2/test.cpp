@@ -6,10 +6,10 @@
 #include <string>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
+#include <cstdio>
 
-struct Seg {
-    int L, R, idx;
-};
+#include "cover.hpp"
 
 std::vector<Seg> greedy_cover(std::vector<Seg> segs, int M) {
     std::sort(segs.begin(), segs.end(), [](const Seg& a, const Seg& b){
@@ -81,6 +81,196 @@ std::vector<Seg> generate_test(int N, int M, TestKind kind, std::mt19937 &rng) {
     return segs;
 }
 
+// Сквозной прогон исходной схемы: iostream, std::sort, сортировка ответа по idx.
+static std::size_t run_baseline(const std::string& input) {
+    std::istringstream in(input);
+    int N;
+    in >> N;
+    std::vector<Seg> segs(N);
+    for (int i = 0; i < N; ++i) {
+        in >> segs[i].L >> segs[i].R;
+        segs[i].idx = i;
+    }
+    int M;
+    in >> M;
+    std::sort(segs.begin(), segs.end(), [](const Seg& a, const Seg& b) { return a.L < b.L; });
+    std::vector<Seg> res;
+    if (!greedy_cover_sorted(segs, M, res)) return 0;
+    std::sort(res.begin(), res.end(), [](const Seg& a, const Seg& b) { return a.idx < b.idx; });
+    return res.size();
+}
+
+// Режим --fast: блочное чтение, поразрядная сортировка, битовая карта индексов.
+static std::size_t run_fast(const std::string& input) {
+    FastReader in(input.data(), input.size());
+    int N;
+    in.readInt(N);
+    std::vector<Seg> segs(N);
+    for (int i = 0; i < N; ++i) {
+        in.readInt(segs[i].L);
+        in.readInt(segs[i].R);
+        segs[i].idx = i;
+    }
+    int M = 0;
+    in.readInt(M);
+    radix_sort_by_L(segs);
+    std::vector<Seg> res;
+    if (!greedy_cover_sorted(segs, M, res)) return 0;
+    return order_by_idx(res, N).size();
+}
+
+static void bench_throughput(std::mt19937& rng) {
+    std::cout << "\nN,input_mb,baseline_ms,fast_ms,baseline_mb_s,fast_mb_s,selected\n";
+    for (int N : {100000, 1000000, 10000000}) {
+        auto segs = generate_test(N, N, TestKind::RANDOM, rng);
+        std::string input;
+        input.reserve(static_cast<std::size_t>(N) * 16);
+        input += std::to_string(N) + "\n";
+        for (auto& s : segs) input += std::to_string(s.L) + " " + std::to_string(s.R) + "\n";
+        input += std::to_string(N) + "\n";
+        double mb = input.size() / 1e6;
+
+        auto t0 = std::chrono::high_resolution_clock::now();
+        std::size_t a = run_baseline(input);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        std::size_t b = run_fast(input);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        double base_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        double fast_ms = std::chrono::duration<double, std::milli>(t2 - t1).count();
+
+        std::cout << N << "," << std::fixed << std::setprecision(3) << mb << "," << base_ms << "," << fast_ms << ","
+                  << mb / base_ms * 1000 << "," << mb / fast_ms * 1000 << "," << b << (a == b ? "" : " MISMATCH") << "\n";
+    }
+}
+
+// Жадный проход от точки a до b за O(N) — эталон для CoverIndex.
+static int brute_cover(const std::vector<Seg>& sorted, int a, int b) {
+    if (b <= a) return 0;
+    int cur = a, cnt = 0;
+    std::size_t i = 0;
+    int bestR = a;
+    while (cur < b) {
+        bool found = false;
+        while (i < sorted.size() && sorted[i].L <= cur) {
+            if (sorted[i].R > bestR) {
+                bestR = sorted[i].R;
+                found = true;
+            }
+            ++i;
+        }
+        if (!found) return -1;
+        ++cnt;
+        cur = bestR;
+    }
+    return cnt;
+}
+
+static void bench_queries(std::mt19937& rng) {
+    std::cout << "\nN,queries,build_ms,query_us,brute_us,mismatches\n";
+    for (int N : {1000, 10000, 100000, 1000000}) {
+        auto segs = generate_test(N, N, TestKind::RANDOM, rng);
+        auto t0 = std::chrono::high_resolution_clock::now();
+        CoverIndex index(segs);
+        auto t1 = std::chrono::high_resolution_clock::now();
+
+        std::vector<Seg> sorted = segs;
+        radix_sort_by_L(sorted);
+        std::uniform_int_distribution<int> pt(-N / 2, N + N / 2);
+        const int Q = 2000;
+        std::vector<std::pair<int, int>> qs(Q);
+        for (auto& q : qs) {
+            q.first = pt(rng);
+            q.second = pt(rng);
+            if (q.first > q.second) std::swap(q.first, q.second);
+        }
+
+        std::vector<int> fast(Q), slow(Q);
+        std::vector<Seg> path;
+        auto t2 = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < Q; ++i) fast[i] = index.query(qs[i].first, qs[i].second);
+        auto t3 = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < Q; ++i) slow[i] = brute_cover(sorted, qs[i].first, qs[i].second);
+        auto t4 = std::chrono::high_resolution_clock::now();
+
+        int bad = 0;
+        for (int i = 0; i < Q; ++i) {
+            if (fast[i] != slow[i]) ++bad;
+            // восстановленный список должен покрывать отрезок и иметь ту же длину
+            if (fast[i] > 0 && i % 50 == 0) {
+                index.query(qs[i].first, qs[i].second, &path);
+                int cur = qs[i].first;
+                for (auto& s : path) if (s.L <= cur && s.R > cur) cur = s.R;
+                if (static_cast<int>(path.size()) != fast[i] || cur < qs[i].second) ++bad;
+            }
+        }
+
+        std::cout << N << "," << Q << "," << std::fixed << std::setprecision(3)
+                  << std::chrono::duration<double, std::milli>(t1 - t0).count() << ","
+                  << std::chrono::duration<double, std::micro>(t3 - t2).count() / Q << ","
+                  << std::chrono::duration<double, std::micro>(t4 - t3).count() / Q << "," << bad << "\n";
+    }
+}
+
+// Случайные вставки и удаления: после каждой операции покрытие DynamicCover
+// сверяется с пакетным greedy_cover_sorted по текущему набору.
+static void fuzz_dynamic(std::mt19937& rng) {
+    std::cout << "\nN,ops,dynamic_us,batch_us,mismatches\n";
+    for (int N : {50, 1000, 20000}) {
+        const int M = N;
+        auto pool = generate_test(N, M, TestKind::RANDOM, rng);
+        DynamicCover set;
+        std::vector<Seg> alive;
+        std::uniform_int_distribution<int> coord(-M / 10, M + M / 10);
+        int nextIdx = 0;
+        for (int i = 0; i < N / 2; ++i) {
+            pool[i].idx = nextIdx++;
+            set.insert(pool[i]);
+            alive.push_back(pool[i]);
+        }
+
+        const int ops = 2000;
+        int bad = 0;
+        double dyn_us = 0, batch_us = 0;
+        std::vector<Seg> got, want;
+        for (int op = 0; op < ops; ++op) {
+            if (alive.empty() || rng() % 2 == 0) {
+                Seg s;
+                s.L = coord(rng);
+                s.R = s.L + static_cast<int>(rng() % (M / 10 + 2));
+                s.idx = nextIdx++;
+                set.insert(s);
+                alive.push_back(s);
+            } else {
+                std::size_t k = rng() % alive.size();
+                if (!set.erase(alive[k])) ++bad;
+                alive[k] = alive.back();
+                alive.pop_back();
+            }
+
+            auto t0 = std::chrono::high_resolution_clock::now();
+            bool okDyn = set.cover(M, got);
+            auto t1 = std::chrono::high_resolution_clock::now();
+            // при равных L и R пакетный проход берёт первый по порядку ввода,
+            // DynamicCover — с меньшим idx, поэтому вход упорядочен по idx
+            std::vector<Seg> sorted = alive;
+            std::sort(sorted.begin(), sorted.end(), [](const Seg& a, const Seg& b) { return a.idx < b.idx; });
+            radix_sort_by_L(sorted);
+            want.clear();
+            bool okBatch = greedy_cover_sorted(sorted, M, want);
+            auto t2 = std::chrono::high_resolution_clock::now();
+            dyn_us += std::chrono::duration<double, std::micro>(t1 - t0).count();
+            batch_us += std::chrono::duration<double, std::micro>(t2 - t1).count();
+
+            bool same = okDyn == okBatch && (!okDyn || got.size() == want.size());
+            for (std::size_t i = 0; same && okDyn && i < got.size(); ++i) same = got[i].idx == want[i].idx;
+            if (!same) ++bad;
+        }
+
+        std::cout << N << "," << ops << "," << std::fixed << std::setprecision(3)
+                  << dyn_us / ops << "," << batch_us / ops << "," << bad << "\n";
+    }
+}
+
 int main() {
     std::vector<int> Ns = {1000, 5000, 10000, 20000, 50000}; // размеры N
     int trials = 5;
@@ -115,5 +305,9 @@ int main() {
         }
     }
 
+    bench_throughput(rng);
+    bench_queries(rng);
+    fuzz_dynamic(rng);
+
     return 0;
 }
@@ -0,0 +1,462 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+const long double EPS = 1e-12L;
+
+inline int rank_matrix(std::vector<std::vector<long double>> a) {
+    // a: matrix with rows = equations, cols = N
+    int m = static_cast<int>(a.size());
+    int n = (m ? static_cast<int>(a[0].size()) : 0);
+    int r = 0;
+
+    for (int col = 0; col < n && r < m; ++col) {
+        // find pivot in [r..m-1]
+        int sel = -1;
+        long double best = 0;
+        for (int i = r; i < m; ++i) {
+            long double val = std::fabs(a[i][col]);
+            if (val > best + EPS) {
+                best = val;
+                sel = i;
+            }
+        }
+        if (sel == -1) continue;
+        std::swap(a[sel], a[r]);
+        long double piv = a[r][col];
+        // normalize row r
+        for (int j = col; j < n; ++j)
+            a[r][j] /= piv;
+        // eliminate
+        for (int i = 0; i < m; ++i) {
+            if (i == r) continue;
+            long double factor = a[i][col];
+            if (std::fabs(factor) <= EPS) continue;
+            for (int j = col; j < n; ++j)
+                a[i][j] -= factor * a[r][j];
+        }
+        ++r;
+    }
+    return r;
+}
+
+// Dense row-major matrix of doubles in one 64-byte aligned buffer. The row
+// stride is padded to a multiple of 8 lanes, so every row starts on a cache
+// line and row kernels can run whole AVX2 vectors without a scalar tail.
+class Matrix {
+private:
+    int m, n, stride_;
+    double* data_;
+
+public:
+    Matrix(int rows, int cols)
+        : m(rows), n(cols), stride_((cols + 7) & ~7), data_(nullptr) {
+        std::size_t bytes = static_cast<std::size_t>(m) * stride_ * sizeof(double);
+        if (bytes == 0) return;
+        data_ = static_cast<double*>(std::aligned_alloc(64, bytes));
+        if (!data_) throw std::bad_alloc();
+        std::fill(data_, data_ + static_cast<std::size_t>(m) * stride_, 0.0);
+    }
+
+    Matrix(const Matrix&) = delete;
+    Matrix& operator=(const Matrix&) = delete;
+
+    ~Matrix() { std::free(data_); }
+
+    int rows() const { return m; }
+    int cols() const { return n; }
+    int stride() const { return stride_; }
+
+    double* row(int i) { return data_ + static_cast<std::size_t>(i) * stride_; }
+    const double* row(int i) const { return data_ + static_cast<std::size_t>(i) * stride_; }
+
+    void swap_rows(int a, int b) {
+        if (a != b) std::swap_ranges(row(a), row(a) + stride_, row(b));
+    }
+};
+
+// y[j] -= f * x[j] for j in [from, to); from and to are multiples of 4 and both
+// rows are 32-byte aligned at from.
+inline void row_axpy(double* y, const double* x, double f, int from, int to) {
+#if defined(__AVX2__)
+    const __m256d vf = _mm256_set1_pd(f);
+    for (int j = from; j < to; j += 4) {
+        __m256d vy = _mm256_load_pd(y + j);
+        __m256d vx = _mm256_load_pd(x + j);
+#if defined(__FMA__)
+        vy = _mm256_fnmadd_pd(vf, vx, vy);
+#else
+        vy = _mm256_sub_pd(vy, _mm256_mul_pd(vf, vx));
+#endif
+        _mm256_store_pd(y + j, vy);
+    }
+#else
+    for (int j = from; j < to; ++j)
+        y[j] -= f * x[j];
+#endif
+}
+
+// Pivot threshold relative to the scale of the matrix, as in LAPACK-style
+// rank estimates: max(m, n) * eps * max |a_ij|. A fixed absolute epsilon
+// would treat a matrix of tiny entries as zero and accept rounding noise as a
+// pivot once the entries are large.
+inline double dense_tolerance(const Matrix& a) {
+    double mx = 0;
+    for (int i = 0; i < a.rows(); ++i)
+        for (int j = 0; j < a.cols(); ++j) mx = std::max(mx, std::fabs(a.row(i)[j]));
+    return mx * std::max(a.rows(), a.cols()) * std::numeric_limits<double>::epsilon();
+}
+
+// Forward elimination with partial pivoting over columns [0, cols), destroying
+// a. Calls on_pivot(col) for every pivot column in order and stops after
+// max_rank pivots. Only rows below the pivot are updated, half the work of
+// the Gauss-Jordan rank_matrix.
+template <class OnPivot>
+int eliminate_dense(Matrix& a, int max_rank, OnPivot on_pivot) {
+    const double tol = dense_tolerance(a);
+    int m = a.rows(), n = a.cols();
+    int r = 0;
+    for (int col = 0; col < n && r < m && r < max_rank; ++col) {
+        int sel = -1;
+        double best = tol;
+        for (int i = r; i < m; ++i) {
+            double val = std::fabs(a.row(i)[col]);
+            if (val > best) {
+                best = val;
+                sel = i;
+            }
+        }
+        if (sel == -1) continue;
+        a.swap_rows(sel, r);
+        const double* pr = a.row(r);
+        double inv = 1.0 / pr[col];
+        // columns left of col are never read again, so start at the aligned lane
+        int from = col & ~3;
+        for (int i = r + 1; i < m; ++i) {
+            double* pi = a.row(i);
+            if (pi[col] == 0) continue;
+            row_axpy(pi, pr, pi[col] * inv, from, a.stride());
+        }
+        on_pivot(col);
+        ++r;
+    }
+    return r;
+}
+
+// Rank of a, destroying it.
+inline int rank_dense(Matrix& a) {
+    return eliminate_dense(a, a.rows(), [](int) {});
+}
+
+// Greedy selection (as with try_add in order) in one dense elimination: the
+// candidates become the columns of an n x M matrix, and a candidate is
+// independent of the earlier ones exactly when its column is a pivot column.
+// Floating point with the relative tolerance above, so unlike ModularBasis it
+// is exact only while the eliminated entries stay well inside double
+// precision; memory is n * M doubles.
+// Returns positions of the accepted rows, stopping at full rank.
+inline std::vector<int> select_dense(const std::vector<const std::vector<int>*>& cand, int n) {
+    const int total = static_cast<int>(cand.size());
+    Matrix a(n, total);
+    for (int k = 0; k < total; ++k)
+        for (int j = 0; j < n; ++j) a.row(j)[k] = (*cand[k])[j];
+    std::vector<int> accepted;
+    eliminate_dense(a, n, [&](int col) { accepted.push_back(col); });
+    return accepted;
+}
+
+// Basis kept in echelon form between candidates: every stored row has 1 in its
+// pivot column and 0 in the pivot columns of all rows added before it.
+// A candidate is reduced against the rows in insertion order in O(rank * N)
+// and is accepted only if a nonzero residual remains.
+class IncrementalBasis {
+private:
+    int n;
+    std::vector<std::vector<long double>> rows;
+    std::vector<int> pivots;
+    std::vector<long double> v;
+
+public:
+    explicit IncrementalBasis(int cols) : n(cols), v(cols) {}
+
+    int rank() const { return static_cast<int>(rows.size()); }
+
+    bool try_add(const std::vector<int>& row) {
+        for (int j = 0; j < n; ++j)
+            v[j] = static_cast<long double>(row[j]);
+
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            long double factor = v[pivots[i]];
+            if (std::fabs(factor) <= EPS) continue;
+            const std::vector<long double>& b = rows[i];
+            for (int j = 0; j < n; ++j)
+                v[j] -= factor * b[j];
+            v[pivots[i]] = 0;
+        }
+
+        int sel = -1;
+        long double best = 0;
+        for (int j = 0; j < n; ++j) {
+            long double val = std::fabs(v[j]);
+            if (val > best + EPS) {
+                best = val;
+                sel = j;
+            }
+        }
+        if (sel == -1) return false;
+
+        long double piv = v[sel];
+        for (int j = 0; j < n; ++j)
+            v[j] /= piv;
+        v[sel] = 1;
+        rows.push_back(v);
+        pivots.push_back(sel);
+        return true;
+    }
+};
+
+// Prime field Z_p for ModularBasis with p drawn at random from [2^60, 2^61)
+// once per process, so no fixed input can be built against it. Residues are
+// kept in Montgomery form (x * 2^64 mod p): a product costs two 64x64
+// multiplies and no division, about as cheap as the Mersenne reduction.
+struct ModField {
+    std::uint64_t p;
+    std::uint64_t pinv; // -p^-1 mod 2^64
+    std::uint64_t r2;   // 2^128 mod p
+
+    static std::uint64_t mulmod(std::uint64_t a, std::uint64_t b, std::uint64_t m) {
+        return static_cast<std::uint64_t>(static_cast<unsigned __int128>(a) * b % m);
+    }
+
+    static std::uint64_t powmod(std::uint64_t a, std::uint64_t e, std::uint64_t m) {
+        std::uint64_t r = 1;
+        for (; e; e >>= 1, a = mulmod(a, a, m))
+            if (e & 1) r = mulmod(r, a, m);
+        return r;
+    }
+
+    // Miller-Rabin with the first 12 primes as bases is exact below 2^64.
+    static bool is_prime(std::uint64_t m) {
+        static const std::uint64_t bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+        for (std::uint64_t b : bases)
+            if (m % b == 0) return m == b;
+        std::uint64_t d = m - 1;
+        int s = 0;
+        for (; d % 2 == 0; d /= 2) ++s;
+        for (std::uint64_t b : bases) {
+            std::uint64_t x = powmod(b, d, m);
+            if (x == 1 || x == m - 1) continue;
+            bool composite = true;
+            for (int i = 1; i < s && composite; ++i) {
+                x = mulmod(x, x, m);
+                composite = (x != m - 1);
+            }
+            if (composite) return false;
+        }
+        return true;
+    }
+
+    explicit ModField(std::uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        do {
+            p = (std::uint64_t(1) << 60) | (rng() >> 4) | 1;
+        } while (!is_prime(p));
+        pinv = p; // Newton: each step doubles the correct low bits of p^-1
+        for (int i = 0; i < 5; ++i) pinv *= 2 - p * pinv;
+        pinv = 0 - pinv;
+        std::uint64_t r = (0 - p) % p; // 2^64 mod p
+        r2 = mulmod(r, r, p);
+    }
+
+    static const ModField& get() {
+        static const ModField f(std::random_device{}() ^ (static_cast<std::uint64_t>(std::random_device{}()) << 32));
+        return f;
+    }
+};
+
+// Exact engine for integer rows: the same incremental echelon basis, but over
+// Z_p (see ModField) instead of long double with EPS.
+// Rows are stored contiguously as packed uint64 residues.
+// Dependence over Q implies dependence mod p, so an accepted row is always
+// truly independent. A truly independent row is rejected only if p divides
+// every N' x N' minor of the rows it was checked with (N' = rank + 1). By
+// Hadamard such a minor is below (sqrt(N) 2^31)^N, so it has fewer than
+// N (31 + log2 N) / 60 prime factors in [2^60, 2^61), out of about 2^54
+// primes there: for N = 1000 one wrong rejection has probability below
+// 2^-44, and over all M checks of a run below M * 2^-44.
+class ModularBasis {
+private:
+    std::uint64_t MOD, pinv, r2;
+
+    int n;
+    std::vector<std::uint64_t> rows; // rank() rows of n residues each
+    std::vector<int> pivots;
+    std::vector<std::uint64_t> v;
+
+    // Montgomery product: a * b / 2^64 mod p
+    std::uint64_t mul(std::uint64_t a, std::uint64_t b) const {
+        unsigned __int128 t = static_cast<unsigned __int128>(a) * b;
+        std::uint64_t m = static_cast<std::uint64_t>(t) * pinv;
+        std::uint64_t r = static_cast<std::uint64_t>((t + static_cast<unsigned __int128>(m) * MOD) >> 64);
+        return r >= MOD ? r - MOD : r;
+    }
+
+    std::uint64_t add(std::uint64_t a, std::uint64_t b) const {
+        std::uint64_t r = a + b;
+        return r >= MOD ? r - MOD : r;
+    }
+
+    // inverse of a Montgomery residue, again in Montgomery form
+    std::uint64_t inverse(std::uint64_t a) const {
+        std::uint64_t res = mul(1, r2), e = MOD - 2;
+        while (e) {
+            if (e & 1) res = mul(res, a);
+            a = mul(a, a);
+            e >>= 1;
+        }
+        return res;
+    }
+
+    std::uint64_t to_mod(int x) const {
+        std::uint64_t r = x >= 0 ? static_cast<std::uint64_t>(x)
+                                 : MOD - static_cast<std::uint64_t>(-static_cast<std::int64_t>(x));
+        return mul(r, r2);
+    }
+
+public:
+    explicit ModularBasis(int cols, const ModField& f = ModField::get())
+        : MOD(f.p), pinv(f.pinv), r2(f.r2), n(cols), v(cols) {}
+
+    int rank() const { return static_cast<int>(pivots.size()); }
+
+    void load(const std::vector<int>& row, std::vector<std::uint64_t>& out) const {
+        out.resize(n);
+        for (int j = 0; j < n; ++j)
+            out[j] = to_mod(row[j]);
+    }
+
+    // Reduces out against basis rows [from, to). Only reads the basis, so
+    // several threads may reduce different rows against it at once.
+    void reduce(std::vector<std::uint64_t>& out, int from, int to) const {
+        for (int i = from; i < to; ++i) {
+            std::uint64_t factor = out[pivots[i]];
+            if (factor == 0) continue;
+            std::uint64_t neg = MOD - factor;
+            const std::uint64_t* b = &rows[static_cast<std::size_t>(i) * n];
+            for (int j = 0; j < n; ++j)
+                out[j] = add(out[j], mul(neg, b[j]));
+        }
+    }
+
+    // Appends a residual already reduced against every basis row, if nonzero.
+    bool commit(std::vector<std::uint64_t>& res) {
+        int sel = -1;
+        for (int j = 0; j < n && sel == -1; ++j)
+            if (res[j] != 0) sel = j;
+        if (sel == -1) return false;
+
+        std::uint64_t inv = inverse(res[sel]);
+        for (int j = 0; j < n; ++j)
+            res[j] = mul(res[j], inv);
+        rows.insert(rows.end(), res.begin(), res.end());
+        pivots.push_back(sel);
+        return true;
+    }
+
+    bool try_add(const std::vector<int>& row) {
+        load(row, v);
+        reduce(v, 0, rank());
+        return commit(v);
+    }
+};
+
+// Greedy selection over rows given in price order, screened in windows on
+// worker threads. Each window is reduced in parallel against a snapshot of the
+// basis. Candidates are then committed one by one in order, first reduced
+// against the rows accepted since the snapshot. The arithmetic is exact, so the
+// result is the same as calling try_add on every row in order.
+// The workers are started once and woken for every window, so a round costs a
+// condition-variable handoff rather than thread creation and small windows
+// stay cheap.
+// Returns positions of the accepted rows, stopping at full rank.
+inline std::vector<int> screen_parallel(const std::vector<const std::vector<int>*>& cand, int n,
+                                        int threads, int window) {
+    ModularBasis basis(n);
+    std::vector<int> accepted;
+    threads = std::max(1, threads);
+    window = std::max(window, threads);
+    std::vector<std::vector<std::uint64_t>> res(window);
+
+    // current round; written only by the main thread while the workers wait
+    int pos = 0, cnt = 0, snapshot = 0;
+    auto work = [&](int t) {
+        for (int k = t; k < cnt; k += threads) {
+            basis.load(*cand[pos + k], res[k]);
+            basis.reduce(res[k], 0, snapshot);
+        }
+    };
+
+    std::mutex mu;
+    std::condition_variable wake, done;
+    long long round = 0;
+    int busy = 0;
+    bool stop = false;
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t)
+        pool.emplace_back([&, t] {
+            long long seen = 0;
+            std::unique_lock<std::mutex> lk(mu);
+            for (;;) {
+                wake.wait(lk, [&] { return stop || round != seen; });
+                if (stop) return;
+                seen = round;
+                lk.unlock();
+                work(t);
+                lk.lock();
+                if (--busy == 0) done.notify_one();
+            }
+        });
+
+    const int total = static_cast<int>(cand.size());
+    for (pos = 0; pos < total && basis.rank() < n; pos += window) {
+        cnt = std::min(window, total - pos);
+        snapshot = basis.rank();
+        if (!pool.empty()) {
+            std::lock_guard<std::mutex> lk(mu);
+            busy = threads - 1;
+            ++round;
+        }
+        wake.notify_all();
+        work(0);
+        if (!pool.empty()) {
+            std::unique_lock<std::mutex> lk(mu);
+            done.wait(lk, [&] { return busy == 0; });
+        }
+
+        for (int k = 0; k < cnt && basis.rank() < n; ++k) {
+            basis.reduce(res[k], snapshot, basis.rank());
+            if (basis.commit(res[k])) accepted.push_back(pos + k);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(mu);
+        stop = true;
+    }
+    wake.notify_all();
+    for (auto& th : pool) th.join();
+    return accepted;
+}
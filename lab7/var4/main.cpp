@@ -1,52 +1,25 @@
-#include <iostream>
 #include <vector>
 #include <cmath>
 #include <algorithm>
 #include <numeric>
+#include <string>
+#include <cstdlib>
 
-int rank_matrix(std::vector<std::vector<long double>> a) {
-    // a: matrix with rows = equations, cols = N
-    int m = static_cast<int>(a.size());
-    int n = (m ? static_cast<int>(a[0].size()) : 0);
-    int r = 0;
-    const long double EPS = 1e-12L;
+#include "basis.hpp"
+#include "../../common/fastio.hpp"
+#include "../../common/instrument.hpp"
 
-    for (int col = 0; col < n && r < m; ++col) {
-        // find pivot in [r..m-1]
-        int sel = -1;
-        long double best = 0;
-        for (int i = r; i < m; ++i) {
-            long double val = std::fabs(a[i][col]);
-            if (val > best + EPS) {
-                best = val;
-                sel = i;
-            }
-        }
-        if (sel == -1) continue;
-        std::swap(a[sel], a[r]);
-        long double piv = a[r][col];
-        // normalize row r
-        for (int j = col; j < n; ++j)
-            a[r][j] /= piv;
-        // eliminate
-        for (int i = 0; i < m; ++i) {
-            if (i == r) continue;
-            long double factor = a[i][col];
-            if (std::fabs(factor) <= EPS) continue;
-            for (int j = col; j < n; ++j)
-                a[i][j] -= factor * a[r][j];
-        }
-        ++r;
-    }
-    return r;
-}
-
-int main() {
-    std::ios::sync_with_stdio(false);
-    std::cin.tie(nullptr);
+// main [--threads T] — with T > 1 candidates are screened on T threads,
+// the chosen set is the same as in the sequential greedy.
+// main --dense       — the whole selection as one vectorized elimination in
+// doubles (select_dense); exact only while the values fit double precision.
+int main(int argc, char** argv) {
+    LAB_PHASE("parse");
+    FastReader in;
+    FastWriter out;
 
     int M, N;
-    if (!(std::cin >> M >> N)) return 0;
+    if (!in.readInt(M) || !in.readInt(N)) return 0;
 
     struct Item {
         std::vector<int> row;
@@ -58,16 +31,18 @@ int main() {
     for (int i = 0; i < M; ++i) {
         items[i].row.resize(N);
         for (int j = 0; j < N; ++j)
-            std::cin >> items[i].row[j];
-        std::cin >> items[i].price;
+            in.readInt(items[i].row[j]);
+        in.readInt(items[i].price);
         items[i].idx = i + 1; // 1-based index
     }
 
     if (M < N) {
-        std::cout << -1 << "\n";
+        out.write("-1\n");
         return 0;
     }
 
+    // phases run until the end of main; output is nested and excluded from build
+    LAB_PHASE("build");
     // sort by price ascending
     std::vector<int> ord(M);
     std::iota(ord.begin(), ord.end(), 0);
@@ -77,34 +52,39 @@ int main() {
         return items[a].idx < items[b].idx;
     });
 
-    std::vector<std::vector<long double>> chosen_rows;
-    std::vector<int> chosen_idx;
-
-    for (int id : ord) {
-        // try to add items[id]
-        chosen_rows.push_back(std::vector<long double>(N));
-        for (int j = 0; j < N; ++j)
-            chosen_rows.back()[j] = static_cast<long double>(items[id].row[j]);
+    int threads = 1;
+    if (argc >= 3 && std::string(argv[1]) == "--threads")
+        threads = std::max(1, std::atoi(argv[2]));
+    bool dense = argc >= 2 && std::string(argv[1]) == "--dense";
 
-        int r = rank_matrix(chosen_rows);
-        if (r > static_cast<int>(chosen_idx.size())) { // rank increased -> keep it
-            chosen_idx.push_back(items[id].idx);
-            if (r == N) break; // got full rank
-        } else {
-            // didn't increase rank -> remove last appended
-            chosen_rows.pop_back();
+    std::vector<int> chosen_idx;
+    if (threads > 1 || dense) {
+        std::vector<const std::vector<int>*> cand;
+        cand.reserve(M);
+        for (int id : ord) cand.push_back(&items[id].row);
+        for (int p : dense ? select_dense(cand, N) : screen_parallel(cand, N, threads, 16 * threads))
+            chosen_idx.push_back(items[ord[p]].idx);
+    } else {
+        ModularBasis basis(N);
+        for (int id : ord) {
+            // keep items[id] only if it is independent of the rows chosen so far
+            if (basis.try_add(items[id].row)) {
+                chosen_idx.push_back(items[id].idx);
+                if (basis.rank() == N) break; // got full rank
+            }
         }
     }
 
+    LAB_PHASE("output");
     if (static_cast<int>(chosen_idx.size()) < N) {
-        std::cout << -1 << "\n";
+        out.write("-1\n");
     } else {
         std::sort(chosen_idx.begin(), chosen_idx.end());
         for (size_t i = 0; i < chosen_idx.size(); ++i) {
-            if (i > 0) std::cout << ' ';
-            std::cout << chosen_idx[i];
+            if (i > 0) out.put(' ');
+            out.writeInt(chosen_idx[i]);
         }
-        std::cout << "\n";
+        out.put('\n');
     }
 
     return 0;
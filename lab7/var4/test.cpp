@@ -1,3 +1,5 @@
+// Компилировать: g++ -std=c++17 test.cpp -O2 -march=native -pthread -o test
+
 #include <iostream>
 #include <vector>
 #include <cmath>
@@ -7,82 +9,168 @@
 #include <sstream>
 #include <chrono>
 
+#include "basis.hpp"
 
-int rank_matrix(std::vector<std::vector<long double>> a) {
-    int m = static_cast<int>(a.size());
-    int n = (m ? static_cast<int>(a[0].size()) : 0);
-    int r = 0;
-    const long double EPS = 1e-12L;
-
-    for (int col = 0; col < n && r < m; ++col) {
-        int sel = -1;
-        long double best = 0;
-        for (int i = r; i < m; ++i) {
-            long double val = std::fabs(a[i][col]);
-            if (val > best + EPS) {
-                best = val;
-                sel = i;
-            }
+struct Item {
+    std::vector<int> row;
+    int price;
+    int idx;
+};
+
+// Исходная схема: полный rank_matrix на каждом кандидате.
+std::vector<int> select_full(const std::vector<Item>& items, const std::vector<int>& ord, int N) {
+    std::vector<std::vector<long double>> chosen_rows;
+    std::vector<int> chosen_idx;
+
+    for (int id : ord) {
+        chosen_rows.push_back(std::vector<long double>(N));
+        for (int j = 0; j < N; ++j)
+            chosen_rows.back()[j] = static_cast<long double>(items[id].row[j]);
+
+        int r = rank_matrix(chosen_rows);
+        if (r > static_cast<int>(chosen_idx.size())) {
+            chosen_idx.push_back(items[id].idx);
+            if (r == N) break;
+        } else {
+            chosen_rows.pop_back();
+        }
+    }
+    return chosen_idx;
+}
+
+template <class Basis>
+std::vector<int> select_incremental(const std::vector<Item>& items, const std::vector<int>& ord, int N) {
+    Basis basis(N);
+    std::vector<int> chosen_idx;
+    for (int id : ord) {
+        if (basis.try_add(items[id].row)) {
+            chosen_idx.push_back(items[id].idx);
+            if (basis.rank() == N) break;
         }
-        if (sel == -1) continue;
-        std::swap(a[sel], a[r]);
-        long double piv = a[r][col];
-        for (int j = col; j < n; ++j)
-            a[r][j] /= piv;
-        for (int i = 0; i < m; ++i) {
-            if (i == r) continue;
-            long double factor = a[i][col];
-            if (std::fabs(factor) <= EPS) continue;
-            for (int j = col; j < n; ++j)
-                a[i][j] -= factor * a[r][j];
+    }
+    return chosen_idx;
+}
+
+enum class Kind {
+    RANDOM,
+    DEGENERATE, // самые дешёвые строки лежат в подпространстве размерности N-1
+    BIG_COEF    // унимодулярная матрица с коэффициентами порядка 2^30, плюс случайные строки
+};
+
+struct TestCase {
+    int M, N;
+    Kind kind;
+};
+
+// Унимодулярная матрица N x N: из единичной случайными элементарными
+// преобразованиями строк, пока коэффициенты не подойдут к 2^30.
+std::vector<std::vector<int>> big_unimodular(int N, std::mt19937_64& rng) {
+    std::vector<std::vector<long long>> a(N, std::vector<long long>(N, 0));
+    for (int i = 0; i < N; ++i) a[i][i] = 1;
+    const long long LIMIT = 1LL << 30;
+    for (int step = 0; step < 200 * N; ++step) {
+        int r = rng() % N, c = rng() % N;
+        if (r == c) continue;
+        long long k = static_cast<long long>(rng() % 7) - 3;
+        bool ok = true;
+        for (int j = 0; j < N && ok; ++j)
+            ok = std::llabs(a[r][j] + k * a[c][j]) < LIMIT;
+        if (!ok) continue;
+        for (int j = 0; j < N; ++j) a[r][j] += k * a[c][j];
+    }
+    std::vector<std::vector<int>> out(N, std::vector<int>(N));
+    for (int i = 0; i < N; ++i)
+        for (int j = 0; j < N; ++j) out[i][j] = static_cast<int>(a[i][j]);
+    return out;
+}
+
+// Ранг квадратной случайной матрицы: rank_matrix (long double) против rank_dense.
+// Для GFLOP/s берётся 2/3 N^3 — число операций прямого хода без выбора строк.
+void bench_dense(int N, bool with_reference) {
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int> dist(-10, 10);
+    std::vector<std::vector<long double>> ref(N, std::vector<long double>(N));
+    Matrix a(N, N);
+    for (int i = 0; i < N; ++i)
+        for (int j = 0; j < N; ++j) {
+            int v = dist(rng);
+            ref[i][j] = v;
+            a.row(i)[j] = v;
         }
-        ++r;
+
+    const double flops = 2.0 * N * N * N / 3.0;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    int r = rank_dense(a);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double sec = std::chrono::duration<double>(t1 - t0).count();
+    std::cout << "dense N=" << N << " rank=" << r << " | " << sec * 1000 << " ms | "
+              << flops / sec / 1e9 << " GFLOP/s";
+
+    if (with_reference) {
+        auto t2 = std::chrono::high_resolution_clock::now();
+        int rr = rank_matrix(ref);
+        auto t3 = std::chrono::high_resolution_clock::now();
+        double rsec = std::chrono::duration<double>(t3 - t2).count();
+        std::cout << " | rank_matrix: " << rsec * 1000 << " ms, "
+                  << 1.5 * flops / rsec / 1e9 << " GFLOP/s" << (rr == r ? "" : " MISMATCH");
     }
-    return r;
+    std::cout << "\n";
 }
 
 int main() {
     std::ios::sync_with_stdio(false);
     std::cin.tie(nullptr);
 
-    std::vector<std::pair<int, int>> tests = {
-        {50, 10},
-        {100, 20},
-        {200, 30},
-        {400, 40},
-        {800, 50},
-        {800, 80},
-        {800, 120}
+    std::vector<TestCase> tests = {
+        {50, 10, Kind::RANDOM},
+        {100, 20, Kind::RANDOM},
+        {200, 30, Kind::RANDOM},
+        {400, 40, Kind::RANDOM},
+        {800, 50, Kind::RANDOM},
+        {800, 80, Kind::RANDOM},
+        {800, 120, Kind::RANDOM},
+        {2000, 40, Kind::DEGENERATE},
+        {100000, 100, Kind::DEGENERATE},
+        {100000, 300, Kind::DEGENERATE},
+        {20, 6, Kind::BIG_COEF},
+        {40, 12, Kind::BIG_COEF}
     };
 
     for (auto test_case : tests) {
-        int M = test_case.first;
-        int N = test_case.second;
+        int M = test_case.M;
+        int N = test_case.N;
 
-        std::vector<std::vector<int>> rows(M, std::vector<int>(N));
-        std::vector<int> prices(M);
         std::mt19937_64 rng(42);
         std::uniform_int_distribution<int> dist(-10, 10);
+        std::uniform_int_distribution<int> coef(-2, 2);
         std::uniform_int_distribution<int> price_dist(1, 1000);
 
-        for (int i = 0; i < M; ++i) {
-            for (int j = 0; j < N; ++j)
-                rows[i][j] = dist(rng);
-            prices[i] = price_dist(rng);
-        }
-
-        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<Item> items(M);
+        std::vector<std::vector<int>> span(std::max(1, N - 1), std::vector<int>(N));
+        for (auto& r : span)
+            for (int j = 0; j < N; ++j) r[j] = dist(rng);
 
-        struct Item {
-            std::vector<int> row;
-            int price;
-            int idx;
-        };
+        std::vector<std::vector<int>> uni;
+        if (test_case.kind == Kind::BIG_COEF) uni = big_unimodular(N, rng);
 
-        std::vector<Item> items(M);
         for (int i = 0; i < M; ++i) {
-            items[i].row = rows[i];
-            items[i].price = prices[i];
+            items[i].row.assign(N, 0);
+            if (test_case.kind == Kind::BIG_COEF) {
+                // самые дешёвые — строки унимодулярной матрицы, ответ ровно они
+                if (i < N) items[i].row = uni[i];
+                else for (int j = 0; j < N; ++j) items[i].row[j] = dist(rng);
+                items[i].price = (i < N) ? 1 : price_dist(rng) + 1;
+            } else if (test_case.kind == Kind::DEGENERATE && i < M - 1) {
+                // линейная комбинация двух строк подпространства
+                const auto& a = span[rng() % span.size()];
+                const auto& b = span[rng() % span.size()];
+                int ca = coef(rng), cb = coef(rng);
+                for (int j = 0; j < N; ++j) items[i].row[j] = ca * a[j] + cb * b[j];
+                items[i].price = price_dist(rng);
+            } else {
+                for (int j = 0; j < N; ++j) items[i].row[j] = dist(rng);
+                items[i].price = (test_case.kind == Kind::DEGENERATE) ? 1001 : price_dist(rng);
+            }
             items[i].idx = i + 1;
         }
 
@@ -91,6 +179,8 @@ int main() {
             continue;
         }
 
+        auto start = std::chrono::high_resolution_clock::now();
+
         std::vector<int> ord(M);
         std::iota(ord.begin(), ord.end(), 0);
         std::sort(ord.begin(), ord.end(), [&](int a, int b) {
@@ -99,38 +189,59 @@ int main() {
             return items[a].idx < items[b].idx;
         });
 
-        std::vector<std::vector<long double>> chosen_rows;
-        std::vector<int> chosen_idx;
-
-        for (int id : ord) {
-            chosen_rows.push_back(std::vector<long double>(N));
-            for (int j = 0; j < N; ++j)
-                chosen_rows.back()[j] = static_cast<long double>(items[id].row[j]);
-
-            int r = rank_matrix(chosen_rows);
-            if (r > static_cast<int>(chosen_idx.size())) {
-                chosen_idx.push_back(items[id].idx);
-                if (r == N) break;
-            } else {
-                chosen_rows.pop_back();
-            }
-        }
+        std::vector<int> chosen_idx = select_incremental<ModularBasis>(items, ord, N);
 
         auto end = std::chrono::high_resolution_clock::now();
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
 
+        // сверка с движком на long double
+        auto lstart = std::chrono::high_resolution_clock::now();
+        std::vector<int> ld_idx = select_incremental<IncrementalBasis>(items, ord, N);
+        auto lend = std::chrono::high_resolution_clock::now();
+        std::string ld = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(lend - lstart).count()) + " ms"
+                       + (ld_idx == chosen_idx ? "" : " MISMATCH");
+
+        // параллельный отсев должен выбрать ровно то же множество
+        std::vector<const std::vector<int>*> cand;
+        for (int id : ord) cand.push_back(&items[id].row);
+        auto pstart = std::chrono::high_resolution_clock::now();
+        std::vector<int> par_idx;
+        for (int p : screen_parallel(cand, N, 4, 64)) par_idx.push_back(items[ord[p]].idx);
+        auto pend = std::chrono::high_resolution_clock::now();
+        std::string par = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(pend - pstart).count()) + " ms"
+                        + (par_idx == chosen_idx ? "" : " MISMATCH");
+
+        // полный пересчёт ранга (тоже long double) кубичен на кандидата, на больших каталогах его не ждём
+        std::string full = "skipped";
+        if (static_cast<long long>(M) * N <= 100000) {
+            auto fstart = std::chrono::high_resolution_clock::now();
+            std::vector<int> ref = select_full(items, ord, N);
+            auto fend = std::chrono::high_resolution_clock::now();
+            full = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(fend - fstart).count()) + " ms"
+                 + (ref == ld_idx ? "" : " MISMATCH");
+        }
+
         if (static_cast<int>(chosen_idx.size()) < N) {
-            std::cout << "M=" << M << " N=" << N << " -> -1 | " << ms << " ms\n";
+            std::cout << "M=" << M << " N=" << N << " -> -1 | " << ms << " ms | 4 threads: " << par << " | long double: " << ld
+                      << " | full: " << full << "\n";
         } else {
             std::cout << "M=" << M << " N=" << N << " -> ";
             std::sort(chosen_idx.begin(), chosen_idx.end());
-            for (std::size_t i = 0; i < chosen_idx.size(); ++i) {
-                if (i > 0) std::cout << ' ';
-                std::cout << chosen_idx[i];
+            if (chosen_idx.size() <= 20) {
+                for (std::size_t i = 0; i < chosen_idx.size(); ++i) {
+                    if (i > 0) std::cout << ' ';
+                    std::cout << chosen_idx[i];
+                }
+            } else {
+                std::cout << chosen_idx.size() << " items";
             }
-            std::cout << " | " << ms << " ms\n";
+            std::cout << " | " << ms << " ms | 4 threads: " << par << " | long double: " << ld
+                      << " | full: " << full << "\n";
         }
     }
 
+    bench_dense(512, true);
+    bench_dense(2048, false);
+
     return 0;
 }
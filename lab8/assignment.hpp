@@ -0,0 +1,475 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <limits>
+#include <cstdlib>
+#include <algorithm>
+#include <functional>
+
+#include "parallel_matching.hpp"
+
+// Взвешенное назначение: паросочетание наибольшего размера, а среди таких —
+// наименьшей суммарной стоимости. Вершины долей пронумерованы отдельно:
+// левые 0..nL-1, правые 0..nR-1.
+struct WeightedEdge {
+    int l, r;
+    long long w;
+};
+
+struct Assignment {
+    int size = 0;
+    long long cost = 0;
+    std::vector<int> matchR; // matchR[r] — левая пара или -1
+};
+
+// Венгерский алгоритм с потенциалами, O(n^2 m) при n <= m, на плотной
+// матрице стоимостей. Отсутствующее ребро стоит BIG = 2 n max|w| + 1: любая
+// пара таких рёбер дороже разницы стоимостей двух паросочетаний, поэтому
+// полное назначение по матрице сначала максимизирует число настоящих рёбер.
+// Потенциалы и приведённые стоимости по модулю не больше 2 (n + 1) BIG;
+// hungarian проверяет эту границу и, если она не влезает в long long с
+// запасом до INF, считает в __int128, как auction.
+template <class T>
+Assignment hungarianAs(int nL, int nR, const std::vector<WeightedEdge> &edges, T BIG, T INF) {
+    const bool flip = nL > nR; // строк должно быть не больше, чем столбцов
+    const int n = flip ? nR : nL, m = flip ? nL : nR;
+
+    // a[i * (m + 1) + j], строки и столбцы с 1
+    std::vector<T> a(static_cast<std::size_t>(n + 1) * (m + 1), BIG);
+    std::vector<char> real(a.size(), 0);
+    for (auto &e : edges) {
+        int i = (flip ? e.r : e.l) + 1, j = (flip ? e.l : e.r) + 1;
+        std::size_t k = static_cast<std::size_t>(i) * (m + 1) + j;
+        if (!real[k] || e.w < a[k]) a[k] = e.w;
+        real[k] = 1;
+    }
+
+    std::vector<T> u(n + 1, 0), v(m + 1, 0), minv(m + 1);
+    std::vector<int> p(m + 1, 0), way(m + 1, 0);
+    std::vector<char> used(m + 1);
+    for (int i = 1; i <= n; ++i) {
+        p[0] = i;
+        int j0 = 0;
+        std::fill(minv.begin(), minv.end(), INF);
+        std::fill(used.begin(), used.end(), 0);
+        do {
+            used[j0] = 1;
+            int i0 = p[j0], j1 = 0;
+            T delta = INF;
+            const T *row = &a[static_cast<std::size_t>(i0) * (m + 1)];
+            for (int j = 1; j <= m; ++j) {
+                if (used[j]) continue;
+                T cur = row[j] - u[i0] - v[j];
+                if (cur < minv[j]) {
+                    minv[j] = cur;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            for (int j = 0; j <= m; ++j) {
+                if (used[j]) {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (p[j0] != 0);
+        do {
+            int j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0);
+    }
+
+    Assignment res;
+    res.matchR.assign(nR, -1);
+    for (int j = 1; j <= m; ++j) {
+        int i = p[j];
+        if (i == 0) continue;
+        std::size_t k = static_cast<std::size_t>(i) * (m + 1) + j;
+        if (!real[k]) continue;
+        int l = flip ? j - 1 : i - 1, r = flip ? i - 1 : j - 1;
+        res.matchR[r] = l;
+        res.cost += static_cast<long long>(a[k]);
+        ++res.size;
+    }
+    return res;
+}
+
+inline Assignment hungarian(int nL, int nR, const std::vector<WeightedEdge> &edges) {
+    using i128 = __int128;
+    const int n = std::min(nL, nR);
+    i128 maxW = 0;
+    for (auto &e : edges) maxW = std::max(maxW, e.w < 0 ? -static_cast<i128>(e.w) : static_cast<i128>(e.w));
+    const i128 BIG = 2 * static_cast<i128>(std::max(n, 1)) * maxW + 1;
+    const long long INF = std::numeric_limits<long long>::max() / 4;
+    if (BIG < INF / (4 * (static_cast<i128>(n) + 1)))
+        return hungarianAs<long long>(nL, nR, edges, static_cast<long long>(BIG), INF);
+    return hungarianAs<i128>(nL, nR, edges, BIG, static_cast<i128>(1) << 124);
+}
+
+// Прямо-двойственный метод для разреженных графов: последовательные
+// кратчайшие увеличивающие пути с потенциалами Джонсона, но за фазу — не один
+// путь, а блокирующий набор. Дейкстра от всех свободных левых вершин по
+// приведённым стоимостям даёт расстояния, потенциалы сдвигаются на них, после
+// чего все кратчайшие пути идут по рёбрам нулевой приведённой стоимости, и
+// непересекающиеся пути по ним набираются DFS, как в Хопкрофте–Карпе.
+// Каждый путь минимален, поэтому после каждой фазы паросочетание —
+// самое дешёвое среди паросочетаний своего размера.
+// Сток T (свободные правые -> T) хранится неявно потенциалом piT.
+inline Assignment primalDual(int nL, int nR, const std::vector<WeightedEdge> &edges) {
+    const long long INF = std::numeric_limits<long long>::max() / 4;
+
+    // CSR левых вершин: правый конец и вес
+    std::vector<int> off(nL + 1, 0);
+    for (auto &e : edges) ++off[e.l + 1];
+    for (int i = 0; i < nL; ++i) off[i + 1] += off[i];
+    std::vector<int> to(edges.size());
+    std::vector<long long> wt(edges.size());
+    {
+        std::vector<int> pos(off.begin(), off.end() - 1);
+        for (auto &e : edges) {
+            to[pos[e.l]] = e.r;
+            wt[pos[e.l]++] = e.w;
+        }
+        // из параллельных рёбер оставляем самое дешёвое
+        std::vector<int> at(nR, -1);
+        int out = 0;
+        for (int l = 0; l < nL; ++l) {
+            int from = off[l];
+            off[l] = out;
+            for (int k = from; k < pos[l]; ++k) {
+                int r = to[k];
+                if (at[r] >= off[l]) {
+                    wt[at[r]] = std::min(wt[at[r]], wt[k]);
+                    continue;
+                }
+                at[r] = out;
+                to[out] = r;
+                wt[out++] = wt[k];
+            }
+        }
+        off[nL] = out;
+        to.resize(out);
+        wt.resize(out);
+    }
+
+    // потенциалы: левые 0, правые — минимальный входящий вес; все приведённые
+    // стоимости неотрицательны
+    std::vector<long long> piL(nL, 0), piR(nR, INF);
+    for (auto &e : edges) piR[e.r] = std::min(piR[e.r], e.w);
+    long long piT = INF;
+    for (int r = 0; r < nR; ++r) {
+        if (piR[r] == INF) piR[r] = 0;
+        piT = std::min(piT, piR[r]);
+    }
+    if (nR == 0) piT = 0;
+
+    std::vector<int> matchL(nL, -1), matchR(nR, -1);
+    std::vector<long long> wMatchL(nL, 0);
+    std::vector<long long> distL(nL), distR(nR);
+    std::vector<int> it(nL);
+    std::vector<unsigned> dead(nL, 0);
+    unsigned phase = 0;
+
+    using Item = std::pair<long long, int>; // расстояние, вершина (правые со сдвигом nL)
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> pq;
+    std::vector<int> stack;
+
+    for (;;) {
+        // Дейкстра до первого извлечения стока
+        std::fill(distL.begin(), distL.end(), INF);
+        std::fill(distR.begin(), distR.end(), INF);
+        for (int l = 0; l < nL; ++l)
+            if (matchL[l] == -1) {
+                distL[l] = 0;
+                pq.push({0, l});
+            }
+        long long distT = INF;
+        while (!pq.empty()) {
+            auto [d, x] = pq.top();
+            pq.pop();
+            if (d >= distT) break;
+            if (x < nL) {
+                if (d != distL[x]) continue;
+                for (int k = off[x]; k < off[x + 1]; ++k) {
+                    int r = to[k];
+                    if (matchL[x] == r) continue;
+                    long long nd = d + wt[k] + piL[x] - piR[r];
+                    if (nd < distR[r]) {
+                        distR[r] = nd;
+                        pq.push({nd, nL + r});
+                    }
+                }
+            } else {
+                int r = x - nL;
+                if (d != distR[r]) continue;
+                int l = matchR[r];
+                if (l == -1) {
+                    distT = std::min(distT, d + piR[r] - piT);
+                } else {
+                    long long nd = d - wMatchL[l] + piR[r] - piL[l];
+                    if (nd < distL[l]) {
+                        distL[l] = nd;
+                        pq.push({nd, l});
+                    }
+                }
+            }
+        }
+        while (!pq.empty()) pq.pop();
+        if (distT == INF) break;
+
+        for (int l = 0; l < nL; ++l) piL[l] += std::min(distL[l], distT);
+        for (int r = 0; r < nR; ++r) piR[r] += std::min(distR[r], distT);
+        piT += distT;
+
+        // блокирующий набор путей по рёбрам нулевой приведённой стоимости
+        ++phase;
+        for (int l = 0; l < nL; ++l) it[l] = off[l];
+        for (int root = 0; root < nL; ++root) {
+            if (matchL[root] != -1 || dead[root] == phase) continue;
+            stack.assign(1, root);
+            dead[root] = phase;
+            while (!stack.empty()) {
+                int v = stack.back();
+                int next = -1;
+                bool done = false;
+                for (; it[v] < off[v + 1]; ++it[v]) {
+                    int k = it[v];
+                    int r = to[k];
+                    if (matchL[v] == r || wt[k] + piL[v] - piR[r] != 0) continue;
+                    int w = matchR[r];
+                    if (w == -1) {
+                        if (piR[r] == piT) {
+                            done = true;
+                            break;
+                        }
+                        continue;
+                    }
+                    if (dead[w] != phase && piR[r] - wMatchL[w] - piL[w] == 0) {
+                        next = w;
+                        break;
+                    }
+                }
+                if (done) {
+                    for (int x : stack) {
+                        int k = it[x]++;
+                        matchL[x] = to[k];
+                        matchR[to[k]] = x;
+                        wMatchL[x] = wt[k];
+                    }
+                    break;
+                }
+                if (next == -1) {
+                    stack.pop_back();
+                    if (!stack.empty()) ++it[stack.back()];
+                    continue;
+                }
+                dead[next] = phase;
+                stack.push_back(next);
+            }
+        }
+    }
+
+    Assignment res;
+    res.matchR = matchR;
+    for (int l = 0; l < nL; ++l) {
+        if (matchL[l] == -1) continue;
+        ++res.size;
+        res.cost += wMatchL[l];
+    }
+    return res;
+}
+
+// Аукцион Бертсекаса с ε-масштабированием для разреженных графов.
+//
+// Задача сводится к совершенному назначению на удвоенном графе. Покупатели —
+// левые вершины и «двойники» правых, предметы — правые вершины и «двойники»
+// левых:
+//   левая i -> правая j    — вес ребра;
+//   левая i -> двойник i   — BIG (i осталась свободной);
+//   двойник j -> правая j  — BIG (j осталась свободной);
+//   двойник j -> двойник i — 0 для каждого ребра (i, j).
+// Паросочетание M вместе с зеркальными рёбрами двойников даёт совершенное
+// назначение стоимости w(M) + BIG (nL + nR - 2|M|), и наоборот. При
+// BIG = n * (max w - min w) + 1 лишняя пара всегда выгоднее, так что оптимум —
+// самое дешёвое среди наибольших паросочетаний. Рёбер 2E + nL + nR.
+//
+// Стоимости умножаются на N + 1 (N — число покупателей), тогда ε = 1 в конце
+// масштабирования даёт точный оптимум. Цены растут до порядка N * BIG * N,
+// поэтому они в __int128. Торги — по Якоби: все свободные покупатели
+// считают ставки параллельно, затем предмет достаётся наибольшей ставке.
+inline Assignment auction(int nL, int nR, const std::vector<WeightedEdge> &edges, int threads = 1) {
+    using i128 = __int128;
+    const int N = nL + nR;
+
+    long long minW = 0, maxW = 0;
+    if (!edges.empty()) minW = maxW = edges[0].w;
+    for (auto &e : edges) {
+        minW = std::min(minW, e.w);
+        maxW = std::max(maxW, e.w);
+    }
+    const long long BIG = static_cast<long long>(std::max(nL, nR)) * (maxW - minW) + 1;
+
+    // покупатели 0..nL-1 — левые, nL..N-1 — двойники правых;
+    // предметы 0..nR-1 — правые, nR..N-1 — двойники левых
+    std::vector<int> off(N + 1, 0);
+    for (auto &e : edges) {
+        ++off[e.l + 1];
+        ++off[nL + e.r + 1];
+    }
+    for (int p = 0; p < N; ++p) off[p + 1] += off[p] + 1; // + ребро к своему двойнику
+    std::vector<int> obj(off[N]);
+    std::vector<long long> cost(off[N]);
+    {
+        std::vector<int> pos(off.begin(), off.end() - 1);
+        for (auto &e : edges) {
+            obj[pos[e.l]] = e.r;
+            cost[pos[e.l]++] = e.w - minW;
+            obj[pos[nL + e.r]] = nR + e.l;
+            cost[pos[nL + e.r]++] = 0;
+        }
+        for (int i = 0; i < nL; ++i) {
+            obj[pos[i]] = nR + i;
+            cost[pos[i]] = BIG;
+        }
+        for (int j = 0; j < nR; ++j) {
+            obj[pos[nL + j]] = j;
+            cost[pos[nL + j]] = BIG;
+        }
+    }
+
+    const i128 scale = N + 1;
+    std::vector<i128> price(N, 0);
+    std::vector<int> owner(N, -1), assigned(N, -1);
+    std::vector<char> drop(N, 0);
+    std::vector<int> freeP, nextFree;
+    std::vector<int> bidObj;
+    std::vector<i128> bidVal;
+    std::vector<i128> best(N);
+    std::vector<int> bestP(N, -1), touched;
+
+    i128 eps = static_cast<i128>(BIG) * scale;
+    for (;;) {
+        eps = eps / 5 > 1 ? eps / 5 : 1; // ε уменьшается в 5 раз за фазу
+
+        // пары, которые и при новом ε остаются ε-оптимальными, сохраняются
+        pm::parallelFor(threads, N, [&](std::size_t b, std::size_t e, int) {
+            for (std::size_t p = b; p < e; ++p) {
+                int j = assigned[p];
+                if (j == -1) continue;
+                i128 top = 0, mine = 0;
+                bool any = false, hasMine = false;
+                for (int t = off[p]; t < off[p + 1]; ++t) {
+                    i128 v = -static_cast<i128>(cost[t]) * scale - price[obj[t]];
+                    if (!any || v > top) top = v;
+                    if (obj[t] == j && (!hasMine || v > mine)) mine = v;
+                    any = true;
+                    hasMine = hasMine || obj[t] == j;
+                }
+                drop[p] = mine < top - eps;
+            }
+        });
+        freeP.clear();
+        for (int p = 0; p < N; ++p) {
+            if (drop[p]) {
+                owner[assigned[p]] = -1;
+                assigned[p] = -1;
+                drop[p] = 0;
+            }
+            if (assigned[p] == -1) freeP.push_back(p);
+        }
+
+        while (!freeP.empty()) {
+            bidObj.resize(freeP.size());
+            bidVal.resize(freeP.size());
+            pm::parallelFor(threads, freeP.size(), [&](std::size_t b, std::size_t e, int) {
+                for (std::size_t k = b; k < e; ++k) {
+                    int p = freeP[k];
+                    int j1 = -1;
+                    i128 v1 = 0, v2 = 0;
+                    bool has2 = false;
+                    for (int t = off[p]; t < off[p + 1]; ++t) {
+                        i128 v = -static_cast<i128>(cost[t]) * scale - price[obj[t]];
+                        if (j1 == -1 || v > v1) {
+                            if (j1 != -1) {
+                                v2 = v1;
+                                has2 = true;
+                            }
+                            v1 = v;
+                            j1 = obj[t];
+                        } else if (!has2 || v > v2) {
+                            v2 = v;
+                            has2 = true;
+                        }
+                    }
+                    bidObj[k] = j1;
+                    // единственный предмет покупателя никому больше не нужен
+                    bidVal[k] = price[j1] + (has2 ? v1 - v2 : 0) + eps;
+                }
+            });
+
+            touched.clear();
+            for (std::size_t k = 0; k < freeP.size(); ++k) {
+                int j = bidObj[k];
+                if (bestP[j] == -1) {
+                    touched.push_back(j);
+                    best[j] = bidVal[k];
+                    bestP[j] = freeP[k];
+                } else if (bidVal[k] > best[j]) {
+                    best[j] = bidVal[k];
+                    bestP[j] = freeP[k];
+                }
+            }
+            nextFree.clear();
+            for (std::size_t k = 0; k < freeP.size(); ++k)
+                if (bestP[bidObj[k]] != freeP[k]) nextFree.push_back(freeP[k]);
+            for (int j : touched) {
+                if (owner[j] != -1) {
+                    assigned[owner[j]] = -1;
+                    nextFree.push_back(owner[j]);
+                }
+                owner[j] = bestP[j];
+                assigned[bestP[j]] = j;
+                price[j] = best[j];
+                bestP[j] = -1;
+            }
+            freeP.swap(nextFree);
+        }
+        if (eps == 1) break;
+    }
+
+    Assignment res;
+    res.matchR.assign(nR, -1);
+    for (int i = 0; i < nL; ++i) {
+        int j = assigned[i];
+        if (j >= nR) continue;
+        res.matchR[j] = i;
+        ++res.size;
+    }
+    // стоимость — по исходным весам; из параллельных рёбер берётся самое дешёвое
+    std::vector<long long> w(nL, 0);
+    std::vector<char> seen(nL, 0);
+    for (auto &e : edges)
+        if (res.matchR[e.r] == e.l && (!seen[e.l] || e.w < w[e.l])) {
+            w[e.l] = e.w;
+            seen[e.l] = 1;
+        }
+    for (int i = 0; i < nL; ++i) res.cost += w[i];
+    return res;
+}
+
+// Выбор движка: плотная матрица, если она не больше 2.5 * 10^7 клеток и
+// рёбер хотя бы восьмая часть от неё, иначе аукцион.
+inline Assignment assign(int nL, int nR, const std::vector<WeightedEdge> &edges, int threads = 1) {
+    long long cells = static_cast<long long>(nL) * nR;
+    if (cells <= 25000000 && cells <= 8 * static_cast<long long>(edges.size()))
+        return hungarian(nL, nR, edges);
+    return auction(nL, nR, edges, threads);
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <memory_resource>
+
+#include "matching.hpp"
+
+// Максимальное паросочетание, которое поддерживается при вставке и удалении
+// рёбер. Граф должен оставаться двудольным; доли явно не хранятся — mate[v]
+// симметричен, а чередующийся поиск в двудольном графе сам ходит по долям.
+//
+// Инвариант — паросочетание максимально. Тогда после изменения одного ребра
+// размер меняется не больше чем на 1, а увеличивающий путь обязан проходить
+// через изменённое место, поэтому хватает поисков от концов ребра:
+//   вставка (a, b): если свободен один из концов — поиск от него; если заняты
+//     оба, путь имеет вид x ~> mate[a] - a - b - mate[b] ~> y, и две половины
+//     ищутся независимо от mate[b] и от mate[a] при запрещённых a и b.
+//     Общая вершина у половин дала бы увеличивающий путь без нового ребра,
+//     чего при максимальном паросочетании быть не может, так что они не
+//     пересекаются;
+//   удаление ребра из паросочетания: освободившиеся a и b — единственные
+//     возможные концы нового пути, поиск от a, затем от b.
+//
+// Списки соседей — n мелких растущих векторов; их память берётся из
+// переданного std::pmr-ресурса (в main — пул), по умолчанию из общей кучи.
+class DynamicMatching {
+private:
+    std::pmr::vector<std::pmr::vector<int>> adj;
+    std::vector<int> mate;
+    int matched = 0;
+
+    std::vector<unsigned> stamp;
+    unsigned epoch = 0;
+    std::vector<int> stack, cur;
+
+    struct Path {
+        std::vector<int> from, to; // вершина пути и выбранный из неё сосед
+    };
+
+    void nextEpoch() {
+        if (++epoch == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0u);
+            epoch = 1;
+        }
+    }
+
+    // Чередующийся путь от root (первое ребро — не из паросочетания) до
+    // свободной вершины. Паросочетание не меняет, путь кладёт в out.
+    // Вершины с текущей отметкой считаются запрещёнными.
+    bool search(int root, Path& out) {
+        stack.assign(1, root);
+        stamp[root] = epoch;
+        cur[root] = 0;
+        while (!stack.empty()) {
+            int v = stack.back();
+            const std::pmr::vector<int>& nb = adj[v];
+            int i = cur[v];
+            int w = -1;
+            for (; i < static_cast<int>(nb.size()); ++i) {
+                int u = nb[i];
+                if (u == mate[v] || stamp[u] == epoch) continue;
+                w = mate[u];
+                if (w == -1 || stamp[w] != epoch) break;
+            }
+            cur[v] = i;
+            if (i == static_cast<int>(nb.size())) {
+                stack.pop_back();
+                if (!stack.empty()) ++cur[stack.back()];
+                continue;
+            }
+            if (w == -1) {
+                out.from = stack;
+                out.to.clear();
+                for (int x : stack) out.to.push_back(adj[x][cur[x]]);
+                return true;
+            }
+            stamp[nb[i]] = epoch;
+            stamp[w] = epoch;
+            cur[w] = 0;
+            stack.push_back(w);
+        }
+        return false;
+    }
+
+    void apply(const Path& p) {
+        for (std::size_t k = 0; k < p.from.size(); ++k) {
+            mate[p.from[k]] = p.to[k];
+            mate[p.to[k]] = p.from[k];
+        }
+    }
+
+    bool augmentFrom(int v) {
+        Path p;
+        nextEpoch();
+        if (!search(v, p)) return false;
+        apply(p);
+        ++matched;
+        return true;
+    }
+
+public:
+    explicit DynamicMatching(int n, std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : adj(n, mr), mate(n, -1), stamp(n, 0), cur(n, 0) {}
+
+    // Начальное состояние из статического графа и его максимального паросочетания.
+    DynamicMatching(const Graph& g, const std::vector<int>& matchR,
+                    std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : DynamicMatching(g.size(), mr) {
+        for (int v = 0; v < g.size(); ++v) adj[v].assign(g.begin(v), g.end(v));
+        for (int u = 0; u < g.size(); ++u) {
+            if (matchR[u] == -1) continue;
+            mate[u] = matchR[u];
+            mate[matchR[u]] = u;
+            ++matched;
+        }
+    }
+
+    int size() const { return matched; }
+    int vertices() const { return static_cast<int>(adj.size()); }
+    int partner(int v) const { return mate[v]; }
+
+    void addEdge(int a, int b) {
+        adj[a].push_back(b);
+        adj[b].push_back(a);
+
+        if (mate[a] == -1 && mate[b] == -1) {
+            mate[a] = b;
+            mate[b] = a;
+            ++matched;
+            return;
+        }
+        if (mate[a] == -1 || mate[b] == -1) {
+            augmentFrom(mate[a] == -1 ? a : b);
+            return;
+        }
+        if (mate[a] == b) return;
+
+        int ra = mate[a], rb = mate[b];
+        Path pa, pb;
+        nextEpoch();
+        stamp[a] = stamp[b] = epoch;
+        if (!search(rb, pb)) return;
+        nextEpoch();
+        stamp[a] = stamp[b] = epoch;
+        if (!search(ra, pa)) return;
+        apply(pb);
+        apply(pa);
+        mate[a] = b;
+        mate[b] = a;
+        ++matched;
+    }
+
+    // Удаляет одну копию ребра; false, если такого ребра нет.
+    bool removeEdge(int a, int b) {
+        auto drop = [](std::pmr::vector<int>& nb, int x) {
+            auto it = std::find(nb.begin(), nb.end(), x);
+            if (it == nb.end()) return false;
+            *it = nb.back();
+            nb.pop_back();
+            return true;
+        };
+        if (!drop(adj[a], b)) return false;
+        drop(adj[b], a);
+
+        if (mate[a] != b) return true;
+        // осталась параллельная копия — пара держится на ней
+        if (std::find(adj[a].begin(), adj[a].end(), b) != adj[a].end()) return true;
+
+        mate[a] = mate[b] = -1;
+        --matched;
+        if (!augmentFrom(a)) augmentFrom(b);
+        return true;
+    }
+};
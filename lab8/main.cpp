@@ -1,56 +1,112 @@
-#include <iostream>
 #include <vector>
 #include <algorithm>
 #include <queue>
+#include <string>
+#include <memory_resource>
+
+#include "matching.hpp"
+#include "parallel_matching.hpp"
+#include "dynamic_matching.hpp"
+#include "assignment.hpp"
+#include "../common/fastio.hpp"
+#include "../common/instrument.hpp"
 
 
 int n, m;
-std::vector<std::vector<int>> adj;
 std::vector<int> matchR;
-std::vector<char> used;
-
-bool tryKuhn(int v) {
-    if (used[v]) return false;
-    used[v] = 1;
-    for (int u : adj[v]) {
-        if (matchR[u] == -1 || tryKuhn(matchR[u])) {
-            matchR[u] = v;
-            return true;
-        }
+
+void printPairs(std::vector<std::pair<int,int>>& ans, FastWriter& out) {
+    LAB_PHASE("output");
+    std::sort(ans.begin(), ans.end());
+
+    out.writeInt(ans.size());
+    out.put('\n');
+    for (auto &p : ans) {
+        out.writeInt(p.first);
+        out.put(' ');
+        out.writeInt(p.second);
+        out.put('\n');
     }
-    return false;
 }
 
-int main() {
-    std::ios::sync_with_stdio(false);
-    std::cin.tie(nullptr);
+// main --hk    — паросочетание алгоритмом Хопкрофта–Карпа вместо Куна;
+// main --warm   — Кун с жадной начальной инициализацией;
+// main --epoch  — Кун со сбросом посещённых за O(1);
+// main --threads T — раскраска и Хопкрофт–Карп в T потоках;
+// main --dynamic — после графа идут операции «+ a b», «- a b» и «?»; после
+//                  обычного ответа на каждый «?» печатается текущее паросочетание;
+// main --assign [dense|sparse|ssp] — назначение минимальной стоимости среди
+//                  паросочетаний наибольшего размера. Без --weighted все рёбра
+//                  стоят 1. dense — венгерский, sparse — аукцион (в --threads
+//                  потоках), ssp — кратчайшие пути; по умолчанию выбор по плотности.
+//                  После пар печатается строка с суммарной стоимостью.
+// main --assign --weighted — то же, но каждое ребро задаётся тремя числами
+//                  «a b w», w — вес ребра.
+// Формат вывода тот же; --warm может выбрать другое паросочетание того же размера.
+int main(int argc, char** argv) {
+    LAB_PHASE("parse");
+    bool useHK = false;
+    KuhnOptions kopt;
+    int threads = 1;
+    bool dynamic = false;
+    bool assignMode = false;
+    bool weighted = false;
+    std::string assignEngine;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--hk") useHK = true;
+        else if (arg == "--warm") kopt.warmStart = true;
+        else if (arg == "--epoch") kopt.epochMarks = true;
+        else if (arg == "--dynamic") dynamic = true;
+        else if (arg == "--weighted") weighted = true;
+        else if (arg == "--assign") {
+            assignMode = true;
+            std::string next = (i + 1 < argc) ? argv[i + 1] : "";
+            if (next == "dense" || next == "sparse" || next == "ssp") assignEngine = argv[++i];
+        }
+        else if (arg == "--threads" && i + 1 < argc) threads = std::max(1, std::stoi(argv[++i]));
+    }
 
-    std::cin >> n >> m;
-    adj.assign(n + 1, {});
+    FastReader in;
+    FastWriter out;
+    in.tie(&out);
 
+    in.readInt(n);
+    in.readInt(m);
+    std::vector<std::pair<int,int>> edges(m);
+    std::vector<long long> weights;
+    if (assignMode) weights.assign(m, 1);
     for(int i = 0; i < m; ++i) {
-        int a, b;
-        std::cin >> a >> b;
-        adj[a].push_back(b);
-        adj[b].push_back(a);
+        in.readInt(edges[i].first);
+        in.readInt(edges[i].second);
+        if (assignMode && weighted) in.readInt(weights[i]);
     }
 
-    for(int v = 1; v <= n; ++v)
-        std::sort(adj[v].begin(), adj[v].end());
-    
+    // фазы открыты до конца main, вложенные вычитаются из внешних
+    LAB_PHASE("build");
+    // списки соседей уже отсортированы, см. build_graph
+    Graph adj = build_graph(n + 1, edges);
+    if (!assignMode) std::vector<std::pair<int,int>>().swap(edges);
+
     // Покрасим, чтобы в дальнейшем перебирать вершины только из левой доли
-    std::vector<int> color(n + 1, -1);
-    for(int s = 1; s <= n; ++s) {
-        if(color[s] != -1) continue;
-        std::queue<int> q;
-        q.push(s);
-        color[s] = 0;
-        while(!q.empty()) {
-            int v = q.front(); q.pop();
-            for(int u : adj[v]) {
-                if(color[u] == -1) {
-                    color[u] = color[v] ^ 1;
-                    q.push(u);
+    std::vector<int> color;
+    if (threads > 1) {
+        color = pm::colorParallel(adj, threads);
+    } else {
+        color.assign(n + 1, -1);
+        for(int s = 1; s <= n; ++s) {
+            if(color[s] != -1) continue;
+            std::queue<int> q;
+            q.push(s);
+            color[s] = 0;
+            while(!q.empty()) {
+                int v = q.front(); q.pop();
+                for(const int* p = adj.begin(v); p != adj.end(v); ++p) {
+                    int u = *p;
+                    if(color[u] == -1) {
+                        color[u] = color[v] ^ 1;
+                        q.push(u);
+                    }
                 }
             }
         }
@@ -60,14 +116,48 @@ int main() {
     for(int v = 1; v <= n; ++v)
         if(color[v] == 0) lefts.push_back(v);
 
-    matchR.assign(n + 1, -1);
-    used.assign(n + 1, 0);
-
-    for(int v : lefts) {
-        std::fill(used.begin(), used.end(), 0);
-        tryKuhn(v);
+    if (assignMode) {
+        // отдельная нумерация долей: id[v] — номер внутри своей доли
+        std::vector<int> id(n + 1), rights;
+        for (int i = 0; i < static_cast<int>(lefts.size()); ++i) id[lefts[i]] = i;
+        for (int v = 1; v <= n; ++v)
+            if (color[v] != 0) {
+                id[v] = static_cast<int>(rights.size());
+                rights.push_back(v);
+            }
+        std::vector<WeightedEdge> wedges(m);
+        for (int i = 0; i < m; ++i) {
+            int a = edges[i].first, b = edges[i].second;
+            if (color[a] != 0) std::swap(a, b);
+            wedges[i] = {id[a], id[b], weights[i]};
+        }
+        int nL = static_cast<int>(lefts.size()), nR = static_cast<int>(rights.size());
+        LAB_PHASE("query");
+        Assignment res = assignEngine == "dense"  ? hungarian(nL, nR, wedges)
+                       : assignEngine == "sparse" ? auction(nL, nR, wedges, threads)
+                       : assignEngine == "ssp"    ? primalDual(nL, nR, wedges)
+                                                  : assign(nL, nR, wedges, threads);
+        std::vector<std::pair<int,int>> ans;
+        for (int r = 0; r < nR; ++r) {
+            if (res.matchR[r] == -1) continue;
+            int a = lefts[res.matchR[r]], b = rights[r];
+            if (a > b) std::swap(a, b);
+            ans.emplace_back(a, b);
+        }
+        printPairs(ans, out);
+        out.writeInt(res.cost);
+        out.put('\n');
+        return 0;
     }
 
+    LAB_PHASE("query");
+    if (threads > 1)
+        pm::HopcroftKarpParallel(adj, lefts, matchR, threads).run();
+    else if (useHK)
+        HopcroftKarp(adj, lefts, matchR).run();
+    else
+        Kuhn(adj, matchR, kopt).run(lefts);
+
     std::vector<std::pair<int,int>> ans;
     for (int u = 1; u <= n; ++u) {
         if (matchR[u] != -1) {
@@ -76,12 +166,29 @@ int main() {
             ans.emplace_back(a, b);
         }
     }
+    printPairs(ans, out);
 
-    std::sort(ans.begin(), ans.end());
-
-    std::cout << ans.size() << "\n";
-    for (auto &p : ans)
-        std::cout << p.first << " " << p.second << "\n";
+    if (dynamic) {
+        // n мелких растущих списков соседей — из пула, а не по одному из кучи
+        std::pmr::unsynchronized_pool_resource pool;
+        DynamicMatching dm(adj, matchR, &pool);
+        LAB_PHASE("parse");
+        for (int op = in.readChar(); op != -1; op = in.readChar()) {
+            if (op == '?') {
+                ans.clear();
+                for (int v = 1; v <= n; ++v)
+                    if (dm.partner(v) > v) ans.emplace_back(v, dm.partner(v));
+                printPairs(ans, out);
+                continue;
+            }
+            int a = 0, b = 0;
+            in.readInt(a);
+            in.readInt(b);
+            LAB_PHASE("query");
+            if (op == '+') dm.addEdge(a, b);
+            else if (op == '-') dm.removeEdge(a, b);
+        }
+    }
 
     return 0;
 }
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "../common/instrument.hpp"
+
+// Неориентированный граф в сжатом виде (CSR): соседи вершины v лежат в
+// to[off[v] .. off[v+1]). Вместо n векторов — два массива.
+struct Graph {
+    std::vector<int> off;
+    std::vector<int> to;
+
+    int size() const { return static_cast<int>(off.size()) - 1; }
+    const int* begin(int v) const { return to.data() + off[v]; }
+    const int* end(int v) const { return to.data() + off[v + 1]; }
+};
+
+// Строит граф на вершинах 0..n-1 подсчётом степеней, без сортировок.
+// Сначала рёбра раскладываются по концам в порядке ввода, затем список
+// транспонируется: источники обходятся по возрастанию, поэтому каждый список
+// соседей выходит отсортированным — как после std::sort в исходной версии.
+// Граф симметричен, так что транспонированный список совпадает с исходным.
+inline Graph build_graph(int n, const std::vector<std::pair<int, int>>& edges) {
+    std::vector<int> deg(n + 1, 0);
+    for (auto& e : edges) {
+        ++deg[e.first + 1];
+        ++deg[e.second + 1];
+    }
+    for (int v = 0; v < n; ++v) deg[v + 1] += deg[v];
+
+    std::vector<int> raw(deg.back());
+    {
+        std::vector<int> pos(deg.begin(), deg.end() - 1);
+        for (auto& e : edges) {
+            raw[pos[e.first]++] = e.second;
+            raw[pos[e.second]++] = e.first;
+        }
+    }
+
+    Graph g;
+    g.off = deg;
+    g.to.resize(raw.size());
+    std::vector<int> pos(deg.begin(), deg.end() - 1);
+    for (int s = 0; s < n; ++s)
+        for (int i = deg[s]; i < deg[s + 1]; ++i)
+            g.to[pos[raw[i]]++] = s;
+    return g;
+}
+
+// Кун без рекурсии: путь хранится явным стеком, для каждой вершины — курсор на
+// следующее ребро. Порядок перебора тот же, что у рекурсивного tryKuhn,
+// поэтому без warmStart и паросочетание получается то же.
+//
+// Ускорения включаются по отдельности, чтобы их вклад можно было измерить:
+//   warmStart  — сначала жадное максимальное паросочетание: левые вершины по
+//                возрастанию степени берут свободного соседа наименьшей степени,
+//                Кун запускается только от оставшихся свободных;
+//   epochMarks — посещённые вершины помечаются номером запуска, сброс — O(1)
+//                вместо std::fill по всем n, а после неудачного поиска его
+//                можно не делать вовсе.
+struct KuhnOptions {
+    bool warmStart = false;
+    bool epochMarks = false;
+};
+
+class Kuhn {
+private:
+    const Graph& g;
+    std::vector<int>& matchR;
+    KuhnOptions opt;
+    std::vector<char> used;
+    std::vector<unsigned> stamp;
+    unsigned epoch = 0;
+    std::vector<int> cur;
+    std::vector<int> stack;
+
+    template <bool Epoch>
+    bool seen(int w) const {
+        if constexpr (Epoch) return stamp[w] == epoch;
+        else return used[w] != 0;
+    }
+
+    template <bool Epoch>
+    void mark(int w) {
+        if constexpr (Epoch) stamp[w] = epoch;
+        else used[w] = 1;
+    }
+
+    template <bool Epoch>
+    void reset() {
+        if constexpr (Epoch) {
+            if (++epoch == 0) {
+                std::fill(stamp.begin(), stamp.end(), 0u);
+                epoch = 1;
+            }
+        } else {
+            std::fill(used.begin(), used.end(), 0);
+        }
+    }
+
+    template <bool Epoch>
+    bool augment(int root) {
+        LAB_COUNT("lab8.kuhn_augment");
+        stack.clear();
+        stack.push_back(root);
+        mark<Epoch>(root);
+        cur[root] = g.off[root];
+        while (!stack.empty()) {
+            int v = stack.back();
+            // пропускаем рёбра в уже посещённые вершины без выхода в общий цикл
+            int i = cur[v];
+            const int end = g.off[v + 1];
+            int w = -1;
+            for (; i < end; ++i) {
+                w = matchR[g.to[i]];
+                if (w == -1 || !seen<Epoch>(w)) break;
+            }
+            cur[v] = i;
+            if (i == end) {
+                stack.pop_back();
+                if (!stack.empty()) ++cur[stack.back()];
+                continue;
+            }
+            if (w == -1) {
+                // свободная вершина: перекидываем пары вдоль всего стека
+                for (int x : stack) matchR[g.to[cur[x]]] = x;
+                return true;
+            }
+            mark<Epoch>(w);
+            cur[w] = g.off[w];
+            stack.push_back(w);
+        }
+        return false;
+    }
+
+    template <bool Epoch>
+    int augmentAll(const std::vector<int>& lefts, const std::vector<char>& matchedL) {
+        int matched = 0;
+        bool changed = true;
+        for (int v : lefts) {
+            if (matchedL[v]) continue;
+            // После неудачного поиска паросочетание не изменилось, и из
+            // помеченных вершин увеличивающего пути по-прежнему нет — с
+            // номерами запусков их можно не сбрасывать. Живые вершины
+            // обходятся в том же порядке, результат тот же.
+            if (!Epoch || changed) reset<Epoch>();
+            changed = augment<Epoch>(v);
+            if (changed) ++matched;
+        }
+        return matched;
+    }
+
+    // Жадная инициализация; отмечает занятые левые вершины, возвращает их число.
+    int greedy(const std::vector<int>& lefts, std::vector<char>& matchedL) {
+        int n = g.size();
+        int maxDeg = 0;
+        for (int v = 0; v < n; ++v) maxDeg = std::max(maxDeg, g.off[v + 1] - g.off[v]);
+
+        // левые вершины по возрастанию степени подсчётом
+        std::vector<int> cnt(maxDeg + 2, 0);
+        for (int v : lefts) ++cnt[g.off[v + 1] - g.off[v] + 1];
+        for (int d = 0; d <= maxDeg; ++d) cnt[d + 1] += cnt[d];
+        std::vector<int> order(lefts.size());
+        for (int v : lefts) order[cnt[g.off[v + 1] - g.off[v]]++] = v;
+
+        int matched = 0;
+        for (int v : order) {
+            int best = -1, bestDeg = 0;
+            for (const int* p = g.begin(v); p != g.end(v); ++p) {
+                int u = *p;
+                int d = g.off[u + 1] - g.off[u];
+                if (matchR[u] == -1 && (best == -1 || d < bestDeg)) {
+                    best = u;
+                    bestDeg = d;
+                }
+            }
+            if (best != -1) {
+                matchR[best] = v;
+                matchedL[v] = 1;
+                ++matched;
+            }
+        }
+        return matched;
+    }
+
+public:
+    Kuhn(const Graph& graph, std::vector<int>& mr, KuhnOptions o = KuhnOptions())
+        : g(graph), matchR(mr), opt(o) {}
+
+    int run(const std::vector<int>& lefts) {
+        int n = g.size();
+        matchR.assign(n, -1);
+        cur.assign(n, 0);
+        std::vector<char> matchedL(n, 0);
+        int matched = opt.warmStart ? greedy(lefts, matchedL) : 0;
+        if (opt.epochMarks) {
+            stamp.assign(n, 0);
+            epoch = 0;
+            return matched + augmentAll<true>(lefts, matchedL);
+        }
+        used.assign(n, 0);
+        return matched + augmentAll<false>(lefts, matchedL);
+    }
+};
+
+// Хопкрофт–Карп: фаза — BFS от всех свободных вершин левой доли, строящий слои
+// по длине чередующегося пути до первого слоя limit, из которого видна свободная
+// правая вершина, затем DFS по слоям, который находит максимальный набор
+// вершинно-непересекающихся кратчайших увеличивающих путей: свободная правая
+// вершина принимается только из слоя limit. Фаз O(sqrt V), всего O(E sqrt V).
+//
+// lefts — вершины левой доли. Результат в matchR: matchR[u] — пара правой
+// вершины u или -1, как у Куна.
+class HopcroftKarp {
+private:
+    static constexpr int INF = 1 << 30;
+
+    const Graph& g;
+    const std::vector<int>& lefts;
+    std::vector<int>& matchR;
+    std::vector<int> matchL;
+    std::vector<int> dist;
+    std::vector<int> it;    // следующее ребро для DFS в текущей фазе
+    std::vector<int> queue; // очередь BFS, она же стек DFS
+    int limit = INF;        // длина кратчайших увеличивающих путей фазы, в слоях
+
+    bool bfs() {
+        queue.clear();
+        for (int v : lefts) {
+            if (matchL[v] == -1) {
+                dist[v] = 0;
+                queue.push_back(v);
+            } else {
+                dist[v] = INF;
+            }
+        }
+        limit = INF;
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            int v = queue[head];
+            // весь слой limit уже размечен, глубже кратчайших путей нет
+            if (dist[v] >= limit) break;
+            for (const int* p = g.begin(v); p != g.end(v); ++p) {
+                int w = matchR[*p];
+                if (w == -1) {
+                    limit = dist[v];
+                } else if (dist[w] == INF) {
+                    dist[w] = dist[v] + 1;
+                    queue.push_back(w);
+                }
+            }
+        }
+        return limit != INF;
+    }
+
+    bool dfs(int root) {
+        LAB_COUNT("lab8.hk_dfs");
+        std::vector<int>& stack = queue;
+        stack.clear();
+        stack.push_back(root);
+        while (!stack.empty()) {
+            int v = stack.back();
+            if (it[v] == g.off[v + 1]) {
+                dist[v] = INF; // тупик — в этой фазе сюда больше не заходим
+                stack.pop_back();
+                if (!stack.empty()) ++it[stack.back()];
+                continue;
+            }
+            int u = g.to[it[v]];
+            int w = matchR[u];
+            if (w == -1) {
+                if (dist[v] != limit) { // путь был бы длиннее кратчайшего
+                    ++it[v];
+                    continue;
+                }
+                for (int x : stack) {
+                    int y = g.to[it[x]++];
+                    matchL[x] = y;
+                    matchR[y] = x;
+                }
+                return true;
+            }
+            if (dist[v] < limit && dist[w] == dist[v] + 1)
+                stack.push_back(w);
+            else
+                ++it[v];
+        }
+        return false;
+    }
+
+public:
+    HopcroftKarp(const Graph& graph, const std::vector<int>& l, std::vector<int>& mr)
+        : g(graph), lefts(l), matchR(mr) {}
+
+    int run() {
+        int n = g.size();
+        matchR.assign(n, -1);
+        matchL.assign(n, -1);
+        dist.assign(n, INF);
+        it.assign(n, 0);
+
+        int matched = 0;
+        while (bfs()) {
+            LAB_COUNT("lab8.hk_phases");
+            for (int v : lefts) it[v] = g.off[v];
+            for (int v : lefts)
+                if (matchL[v] == -1 && dfs(v)) ++matched;
+        }
+        return matched;
+    }
+};
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+#include "matching.hpp"
+
+// Параллельные версии раскраски и Хопкрофта–Карпа. Потоки создаются на каждый
+// уровень BFS / фазу DFS; на маленьких объёмах работа идёт в вызывающем потоке.
+namespace pm {
+
+template <class F>
+void parallelFor(int threads, std::size_t n, F fn) {
+    if (threads <= 1 || n < 4096) {
+        fn(std::size_t(0), n, 0);
+        return;
+    }
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    std::size_t chunk = (n + threads - 1) / threads;
+    for (int t = 1; t < threads; ++t) {
+        std::size_t b = std::min(n, chunk * t), e = std::min(n, b + chunk);
+        pool.emplace_back(fn, b, e, t);
+    }
+    fn(std::size_t(0), std::min(n, chunk), 0);
+    for (auto &th : pool) th.join();
+}
+
+// Двухцветная раскраска BFS по уровням: фронт делится между потоками, вершина
+// достаётся тому, кто первым поставит ей цвет через CAS. В двудольной
+// компоненте цвет вершины — чётность расстояния до стартовой, поэтому
+// раскраска совпадает с последовательной (старт — наименьшая вершина, цвет 0).
+inline std::vector<int> colorParallel(const Graph &g, int threads) {
+    const int n = g.size();
+    threads = std::max(1, threads);
+    std::vector<std::atomic<int>> color(n);
+    for (auto &c : color) c.store(-1, std::memory_order_relaxed);
+
+    std::vector<int> frontier, next;
+    std::vector<std::vector<int>> local(threads);
+    for (int s = 0; s < n; ++s) {
+        if (color[s].load(std::memory_order_relaxed) != -1) continue;
+        color[s].store(0, std::memory_order_relaxed);
+        frontier.assign(1, s);
+        while (!frontier.empty()) {
+            for (auto &l : local) l.clear();
+            parallelFor(threads, frontier.size(), [&](std::size_t b, std::size_t e, int t) {
+                std::vector<int> &out = local[t];
+                for (std::size_t i = b; i < e; ++i) {
+                    int v = frontier[i];
+                    int c = color[v].load(std::memory_order_relaxed) ^ 1;
+                    for (const int *p = g.begin(v); p != g.end(v); ++p) {
+                        int expected = -1;
+                        if (color[*p].load(std::memory_order_relaxed) == -1 &&
+                            color[*p].compare_exchange_strong(expected, c, std::memory_order_relaxed))
+                            out.push_back(*p);
+                    }
+                }
+            });
+            next.clear();
+            for (auto &l : local) next.insert(next.end(), l.begin(), l.end());
+            frontier.swap(next);
+        }
+    }
+
+    std::vector<int> out(n);
+    for (int v = 0; v < n; ++v) out[v] = color[v].load(std::memory_order_relaxed);
+    return out;
+}
+
+// Хопкрофт–Карп с параллельными фазами. BFS строит слои по уровням, как в
+// colorParallel. В фазе DFS потоки разбирают свободные левые вершины порциями
+// и ищут пути, захватывая каждую вершину через CAS на номер фазы: захваченная
+// вершина принадлежит одному потоку до конца фазы, поэтому найденные пути
+// не пересекаются, а пары вдоль пути меняет только его владелец.
+//
+// Захват жаднее последовательного «тупика»: вершина, занятая чужим путём,
+// который потом не удался, в этой фазе уже недоступна. Если из-за этого фаза
+// ничего не нашла, она повторяется в одном потоке — так каждая фаза
+// продвигается, а цикл, как и обычно, кончается, когда BFS не видит
+// увеличивающих путей, то есть паросочетание максимально.
+class HopcroftKarpParallel {
+private:
+    static constexpr int INF = 1 << 30;
+
+    const Graph &g;
+    const std::vector<int> &lefts;
+    std::vector<int> &matchR;
+    int threads;
+
+    std::vector<std::atomic<int>> mR, mL, dist, claim;
+    std::vector<int> it;
+    std::vector<int> freeLefts;
+    int phase = 0;
+    int limit = INF; // слой, из которого в этой фазе принимается свободная правая вершина
+
+    bool tryClaim(int v) {
+        int c = claim[v].load(std::memory_order_relaxed);
+        return c != phase && claim[v].compare_exchange_strong(c, phase, std::memory_order_relaxed);
+    }
+
+    bool bfs() {
+        std::vector<int> frontier, next;
+        for (int v : lefts) {
+            if (mL[v].load(std::memory_order_relaxed) == -1) {
+                dist[v].store(0, std::memory_order_relaxed);
+                frontier.push_back(v);
+            } else {
+                dist[v].store(INF, std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<bool> found(false);
+        std::vector<std::vector<int>> local(threads);
+        limit = INF;
+        // слои строим до первого уровня, с которого видна свободная правая вершина
+        for (int d = 0; !frontier.empty() && !found.load(); ++d) {
+            for (auto &l : local) l.clear();
+            parallelFor(threads, frontier.size(), [&](std::size_t b, std::size_t e, int t) {
+                std::vector<int> &out = local[t];
+                for (std::size_t i = b; i < e; ++i) {
+                    int v = frontier[i];
+                    for (const int *p = g.begin(v); p != g.end(v); ++p) {
+                        int w = mR[*p].load(std::memory_order_relaxed);
+                        int expected = INF;
+                        if (w == -1) {
+                            found.store(true, std::memory_order_relaxed);
+                        } else if (dist[w].load(std::memory_order_relaxed) == INF &&
+                                   dist[w].compare_exchange_strong(expected, d + 1, std::memory_order_relaxed)) {
+                            out.push_back(w);
+                        }
+                    }
+                }
+            });
+            if (found.load()) limit = d;
+            next.clear();
+            for (auto &l : local) next.insert(next.end(), l.begin(), l.end());
+            frontier.swap(next);
+        }
+        return found.load();
+    }
+
+    bool dfs(int root, std::vector<int> &stack) {
+        stack.assign(1, root);
+        it[root] = g.off[root];
+        while (!stack.empty()) {
+            int v = stack.back();
+            if (it[v] == g.off[v + 1]) {
+                stack.pop_back();
+                if (!stack.empty()) ++it[stack.back()];
+                continue;
+            }
+            int u = g.to[it[v]];
+            int w = mR[u].load(std::memory_order_relaxed);
+            const int dv = dist[v].load(std::memory_order_relaxed);
+            if (w == -1) {
+                // только кратчайшие пути: свободная вершина принимается из слоя limit
+                if (dv != limit || !tryClaim(u)) {
+                    ++it[v];
+                    continue;
+                }
+                for (int x : stack) {
+                    int y = g.to[it[x]];
+                    mL[x].store(y, std::memory_order_relaxed);
+                    mR[y].store(x, std::memory_order_relaxed);
+                }
+                return true;
+            }
+            if (dv < limit && dist[w].load(std::memory_order_relaxed) == dv + 1 && tryClaim(w)) {
+                it[w] = g.off[w];
+                stack.push_back(w);
+            } else {
+                ++it[v];
+            }
+        }
+        return false;
+    }
+
+    int dfsPhase(int workers) {
+        ++phase;
+        std::atomic<std::size_t> next(0);
+        std::atomic<int> augmented(0);
+        const std::size_t total = freeLefts.size();
+        const std::size_t portion = 64;
+
+        auto work = [&]() {
+            std::vector<int> stack;
+            int mine = 0;
+            for (;;) {
+                std::size_t b = next.fetch_add(portion, std::memory_order_relaxed);
+                if (b >= total) break;
+                std::size_t e = std::min(total, b + portion);
+                for (std::size_t i = b; i < e; ++i) {
+                    int v = freeLefts[i];
+                    if (tryClaim(v) && dfs(v, stack)) ++mine;
+                }
+            }
+            augmented.fetch_add(mine, std::memory_order_relaxed);
+        };
+
+        if (workers <= 1 || total < 4096) {
+            work();
+        } else {
+            std::vector<std::thread> pool;
+            for (int t = 1; t < workers; ++t) pool.emplace_back(work);
+            work();
+            for (auto &th : pool) th.join();
+        }
+        return augmented.load();
+    }
+
+public:
+    HopcroftKarpParallel(const Graph &graph, const std::vector<int> &l, std::vector<int> &mr, int t)
+        : g(graph), lefts(l), matchR(mr), threads(std::max(1, t)) {}
+
+    int run() {
+        const int n = g.size();
+        mR = std::vector<std::atomic<int>>(n);
+        mL = std::vector<std::atomic<int>>(n);
+        dist = std::vector<std::atomic<int>>(n);
+        claim = std::vector<std::atomic<int>>(n);
+        for (int v = 0; v < n; ++v) {
+            mR[v].store(-1, std::memory_order_relaxed);
+            mL[v].store(-1, std::memory_order_relaxed);
+            dist[v].store(INF, std::memory_order_relaxed);
+            claim[v].store(0, std::memory_order_relaxed);
+        }
+        it.assign(n, 0);
+        phase = 0;
+
+        int matched = 0;
+        while (bfs()) {
+            freeLefts.clear();
+            for (int v : lefts)
+                if (mL[v].load(std::memory_order_relaxed) == -1) freeLefts.push_back(v);
+            int got = dfsPhase(threads);
+            if (got == 0) got = dfsPhase(1);
+            matched += got;
+        }
+
+        matchR.assign(n, -1);
+        for (int v = 0; v < n; ++v) matchR[v] = mR[v].load(std::memory_order_relaxed);
+        return matched;
+    }
+};
+
+} // namespace pm
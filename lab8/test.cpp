@@ -3,8 +3,18 @@
 #include <algorithm>
 #include <chrono>
 #include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <functional>
 
-struct Kuhn {
+#include "matching.hpp"
+#include "parallel_matching.hpp"
+#include "dynamic_matching.hpp"
+#include "assignment.hpp"
+
+// Исходный движок: списки смежности и рекурсивный Кун — база для сравнения.
+struct KuhnLists {
     int N;
     std::vector<std::vector<int>> adj;
     std::vector<int> matchR;
@@ -39,6 +49,316 @@ struct Kuhn {
     }
 };
 
+enum class GraphKind {
+    RANDOM,     // по 3 случайных ребра из каждой левой вершины
+    PLANTED,    // ребро i - (nL+i) и ещё 2 случайных: совершенное паросочетание есть
+    TRIANGULAR  // левая i соединена с правыми 1..i
+};
+
+static const char* kind_name(GraphKind k) {
+    return k == GraphKind::RANDOM ? "random" : (k == GraphKind::PLANTED ? "planted" : "adversarial");
+}
+
+// Рёбра графа из nL левых (1..nL) и nL правых (nL+1..2nL) вершин.
+static std::vector<std::pair<int, int>> make_edges(int nL, GraphKind kind, std::mt19937& rng) {
+    std::vector<std::pair<int, int>> edges;
+    if (kind == GraphKind::TRIANGULAR) {
+        // левая i соединена с правыми 1..i: Кун на каждой новой вершине
+        // обходит все ранее сопоставленные, итого O(V * E)
+        for (int i = 1; i <= nL; ++i)
+            for (int j = 1; j <= i; ++j) edges.emplace_back(i, nL + j);
+    } else {
+        std::uniform_int_distribution<int> pick(1, nL);
+        for (int i = 1; i <= nL; ++i) {
+            if (kind == GraphKind::PLANTED) edges.emplace_back(i, nL + i);
+            for (int k = (kind == GraphKind::PLANTED ? 1 : 0); k < 3; ++k) edges.emplace_back(i, nL + pick(rng));
+        }
+    }
+    return edges;
+}
+
+static KuhnLists make_lists(int V, const std::vector<std::pair<int, int>>& edges) {
+    KuhnLists g;
+    g.init(V);
+    for (auto& e : edges) {
+        g.adj[e.first].push_back(e.second);
+        g.adj[e.second].push_back(e.first);
+    }
+    for (auto& a : g.adj) std::sort(a.begin(), a.end());
+    return g;
+}
+
+static std::string ms_since(std::chrono::high_resolution_clock::time_point t0) {
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(3) << std::chrono::duration<double, std::milli>(t1 - t0).count();
+    return os.str();
+}
+
+// Кун (рекурсивный на списках и итеративный на CSR) против Хопкрофта–Карпа.
+// Куна на больших случайных графах не ждём: только сброс used стоит O(V^2).
+static void bench_engines() {
+    std::cout << "\ngraph,nL,E,matching,kuhn_ms,kuhn_csr_ms,hk_ms\n";
+    std::mt19937 rng(2024);
+    for (GraphKind kind : {GraphKind::RANDOM, GraphKind::TRIANGULAR}) {
+        bool adversarial = (kind == GraphKind::TRIANGULAR);
+        std::vector<int> sizes = adversarial ? std::vector<int>{250, 500, 1000, 2000, 4000}
+                                             : std::vector<int>{1000, 10000, 100000, 1000000};
+        for (int nL : sizes) {
+            auto edges = make_edges(nL, kind, rng);
+            Graph g = build_graph(2 * nL + 1, edges);
+            std::vector<int> lefts;
+            for (int i = 1; i <= nL; ++i) lefts.push_back(i);
+
+            std::vector<int> matchR;
+            auto t0 = std::chrono::high_resolution_clock::now();
+            int hk = HopcroftKarp(g, lefts, matchR).run();
+            std::string hk_ms = ms_since(t0);
+
+            std::string kuhn = "skipped", kuhn_csr = "skipped";
+            if (adversarial || nL <= 10000) {
+                KuhnLists lists = make_lists(2 * nL, edges);
+                auto t1 = std::chrono::high_resolution_clock::now();
+                int km = lists.run(lefts);
+                kuhn = ms_since(t1) + (km == hk ? "" : " MISMATCH");
+
+                auto t2 = std::chrono::high_resolution_clock::now();
+                int kc = Kuhn(g, matchR).run(lefts);
+                kuhn_csr = ms_since(t2) + (kc == hk ? "" : " MISMATCH");
+            }
+
+            std::cout << kind_name(kind) << "," << nL << "," << edges.size() << ","
+                      << hk << "," << kuhn << "," << kuhn_csr << "," << hk_ms << "\n";
+        }
+    }
+}
+
+// Вклад жадной инициализации и сброса по номеру запуска по отдельности.
+// Когда увеличивающие пути короткие (planted), время уходит на std::fill;
+// на random часть поисков неудачна и обходит почти весь граф, сброс там не главное.
+static void bench_kuhn_options() {
+    std::cout << "\ngraph,nL,E,matching,plain_ms,epoch_ms,warm_ms,warm_epoch_ms\n";
+    std::mt19937 rng(99);
+    for (GraphKind kind : {GraphKind::PLANTED, GraphKind::RANDOM, GraphKind::TRIANGULAR}) {
+        std::vector<int> sizes = kind == GraphKind::TRIANGULAR ? std::vector<int>{1000, 2000}
+                                                               : std::vector<int>{10000, 50000, 100000};
+        for (int nL : sizes) {
+            auto edges = make_edges(nL, kind, rng);
+            Graph g = build_graph(2 * nL + 1, edges);
+            std::vector<int> lefts;
+            for (int i = 1; i <= nL; ++i) lefts.push_back(i);
+
+            std::vector<int> matchR;
+            int ref = HopcroftKarp(g, lefts, matchR).run();
+            std::cout << kind_name(kind) << "," << nL << "," << edges.size() << "," << ref;
+            for (int mode = 0; mode < 4; ++mode) {
+                KuhnOptions o;
+                o.epochMarks = (mode & 1) != 0;
+                o.warmStart = (mode & 2) != 0;
+                auto t0 = std::chrono::high_resolution_clock::now();
+                int got = Kuhn(g, matchR, o).run(lefts);
+                std::cout << "," << ms_since(t0) << (got == ref ? "" : " MISMATCH");
+            }
+            std::cout << "\n";
+        }
+    }
+}
+
+// Паросочетание корректно: пары взаимны и каждая — ребро графа.
+static bool valid_matching(const Graph& g, const std::vector<int>& matchR) {
+    std::vector<int> matchL(g.size(), -1);
+    for (int u = 0; u < g.size(); ++u) {
+        int v = matchR[u];
+        if (v == -1) continue;
+        if (matchL[v] != -1 || !std::binary_search(g.begin(v), g.end(v), u)) return false;
+        matchL[v] = u;
+    }
+    return true;
+}
+
+// Масштабирование раскраски и параллельного Хопкрофта–Карпа по числу потоков.
+// Размер паросочетания сверяется с последовательным движком.
+static void bench_parallel() {
+    std::cout << "\ngraph,nL,E,threads,color_ms,match_ms,matching,check\n";
+    std::mt19937 rng(31);
+    for (GraphKind kind : {GraphKind::RANDOM, GraphKind::PLANTED}) {
+        const int nL = 2000000;
+        auto edges = make_edges(nL, kind, rng);
+        Graph g = build_graph(2 * nL + 1, edges);
+        std::vector<int> lefts;
+        for (int i = 1; i <= nL; ++i) lefts.push_back(i);
+
+        std::vector<int> matchR;
+        int ref = HopcroftKarp(g, lefts, matchR).run();
+        std::vector<int> refColor = pm::colorParallel(g, 1);
+
+        for (int threads : {1, 2, 4, 8, 16, 32}) {
+            auto t0 = std::chrono::high_resolution_clock::now();
+            std::vector<int> color = pm::colorParallel(g, threads);
+            std::string color_ms = ms_since(t0);
+
+            auto t1 = std::chrono::high_resolution_clock::now();
+            int got = pm::HopcroftKarpParallel(g, lefts, matchR, threads).run();
+            std::string match_ms = ms_since(t1);
+
+            bool ok = got == ref && color == refColor && valid_matching(g, matchR);
+            std::cout << kind_name(kind) << "," << nL << "," << edges.size() << "," << threads << ","
+                      << color_ms << "," << match_ms << "," << got << "," << (ok ? "ok" : "MISMATCH") << "\n";
+        }
+    }
+}
+
+// Случайные вставки и удаления рёбер: после каждой операции размер
+// DynamicMatching сверяется с Хопкрофтом–Карпом с нуля по текущим рёбрам,
+// а пары — на корректность. Время — среднее на операцию.
+static void fuzz_dynamic() {
+    std::cout << "\nnL,E0,ops,update_us,recompute_us,mismatches\n";
+    std::mt19937 rng(5);
+    for (int nL : {20, 300, 20000}) {
+        auto edges = make_edges(nL, GraphKind::RANDOM, rng);
+        Graph g = build_graph(2 * nL + 1, edges);
+        std::vector<int> lefts;
+        for (int i = 1; i <= nL; ++i) lefts.push_back(i);
+        std::vector<int> matchR;
+        HopcroftKarp(g, lefts, matchR).run();
+        DynamicMatching dm(g, matchR);
+
+        std::uniform_int_distribution<int> pick(1, nL);
+        const int ops = nL <= 300 ? 3000 : 300;
+        int bad = 0;
+        double upd_us = 0, full_us = 0;
+        for (int op = 0; op < ops; ++op) {
+            auto t0 = std::chrono::high_resolution_clock::now();
+            if (edges.empty() || rng() % 2 == 0) {
+                std::pair<int, int> e(pick(rng), nL + pick(rng));
+                if (rng() % 2) std::swap(e.first, e.second);
+                edges.push_back(e);
+                dm.addEdge(e.first, e.second);
+            } else {
+                std::size_t k = rng() % edges.size();
+                if (!dm.removeEdge(edges[k].first, edges[k].second)) ++bad;
+                edges[k] = edges.back();
+                edges.pop_back();
+            }
+            auto t1 = std::chrono::high_resolution_clock::now();
+            upd_us += std::chrono::duration<double, std::micro>(t1 - t0).count();
+
+            Graph cur = build_graph(2 * nL + 1, edges);
+            int ref = HopcroftKarp(cur, lefts, matchR).run();
+            full_us += std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - t1).count();
+
+            std::vector<int> pairs(cur.size(), -1);
+            for (int v = 1; v <= nL; ++v) {
+                int u = dm.partner(v);
+                if (u == -1) continue;
+                if (dm.partner(u) != v) ++bad;
+                pairs[u] = v;
+            }
+            if (dm.size() != ref || !valid_matching(cur, pairs)) ++bad;
+        }
+        std::cout << nL << "," << 3 * nL << "," << ops << "," << std::fixed << std::setprecision(3)
+                  << upd_us / ops << "," << full_us / ops << "," << bad << "\n";
+    }
+}
+
+// Взвешенное назначение. Полные графы — венгерский и аукцион, разреженные
+// (по 3 ребра из левой вершины) — аукцион и кратчайшие пути там, где они
+// успевают. Размер и стоимость сверяются с первым движком в строке группы.
+static void bench_assignment() {
+    std::cout << "\nengine,V,E,max_w,size,cost,ms,check\n";
+    std::mt19937 rng(17);
+
+    auto run = [&](const char* name, int V, const std::vector<WeightedEdge>& we, int maxW,
+                   const std::function<Assignment()>& engine, const Assignment* ref) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        Assignment a = engine();
+        std::string ms = ms_since(t0);
+        std::string check = "-";
+        if (ref) check = (ref->size == a.size && ref->cost == a.cost) ? "ok" : "MISMATCH";
+        std::cout << name << "," << V << "," << we.size() << "," << maxW << "," << a.size << "," << a.cost << ","
+                  << ms << "," << check << std::endl;
+        return a;
+    };
+
+    for (int nL : {500, 1000, 2000}) {
+        std::uniform_int_distribution<int> w(1, 1000000);
+        std::vector<WeightedEdge> we;
+        for (int i = 0; i < nL; ++i)
+            for (int j = 0; j < nL; ++j) we.push_back({i, j, w(rng)});
+        Assignment ref = run("hungarian", 2 * nL, we, 1000000, [&] { return hungarian(nL, nL, we); }, nullptr);
+        if (nL <= 1000) run("auction", 2 * nL, we, 1000000, [&] { return auction(nL, nL, we, 4); }, &ref);
+    }
+
+    for (int maxW : {100, 1000000}) {
+        for (int V : {10000, 100000, 1000000}) {
+            const int nL = V / 2;
+            std::uniform_int_distribution<int> pick(0, nL - 1), w(1, maxW);
+            std::vector<WeightedEdge> we;
+            for (int i = 0; i < nL; ++i)
+                for (int k = 0; k < 3; ++k) we.push_back({i, pick(rng), w(rng)});
+            Assignment ref = run("auction", V, we, maxW, [&] { return auction(nL, nL, we, 4); }, nullptr);
+            // кратчайшим путям нужно по фазе на каждое различное расстояние
+            if (V <= 10000 || (V <= 100000 && maxW <= 100))
+                run("ssp", V, we, maxW, [&] { return primalDual(nL, nL, we); }, &ref);
+        }
+    }
+}
+
+// Построение и обход (BFS-раскраска) графа с 10^7 рёбрами: списки смежности
+// с сортировкой против CSR. Память — байты под данные плюс заголовки векторов.
+static void bench_layout() {
+    std::cout << "\nlayout,V,E,build_ms,bfs_ms,bytes\n";
+    std::mt19937 rng(7);
+    const int nL = 2000000;
+    const int V = 2 * nL;
+    std::vector<std::pair<int, int>> edges;
+    std::uniform_int_distribution<int> pick(1, nL);
+    for (int i = 0; i < 10000000; ++i) edges.emplace_back(pick(rng), nL + pick(rng));
+
+    auto bfs = [V](auto&& neighbours) {
+        std::vector<int> color(V + 1, -1), q;
+        long long seen = 0;
+        for (int s = 1; s <= V; ++s) {
+            if (color[s] != -1) continue;
+            color[s] = 0;
+            q.assign(1, s);
+            for (std::size_t h = 0; h < q.size(); ++h) {
+                int v = q[h];
+                ++seen;
+                neighbours(v, [&](int u) {
+                    if (color[u] == -1) {
+                        color[u] = color[v] ^ 1;
+                        q.push_back(u);
+                    }
+                });
+            }
+        }
+        return seen;
+    };
+
+    {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        KuhnLists lists = make_lists(V, edges);
+        std::string build = ms_since(t0);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        bfs([&](int v, auto&& f) { for (int u : lists.adj[v]) f(u); });
+        std::string walk = ms_since(t1);
+        std::size_t bytes = lists.adj.capacity() * sizeof(std::vector<int>);
+        for (auto& a : lists.adj) bytes += a.capacity() * sizeof(int);
+        std::cout << "lists," << V << "," << edges.size() << "," << build << "," << walk << "," << bytes << "\n";
+    }
+    {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        Graph g = build_graph(V + 1, edges);
+        std::string build = ms_since(t0);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        bfs([&](int v, auto&& f) { for (const int* p = g.begin(v); p != g.end(v); ++p) f(*p); });
+        std::string walk = ms_since(t1);
+        std::size_t bytes = (g.off.capacity() + g.to.capacity()) * sizeof(int);
+        std::cout << "csr," << V << "," << edges.size() << "," << build << "," << walk << "," << bytes << "\n";
+    }
+}
+
 int main() {
     std::ios::sync_with_stdio(false);
     std::cin.tie(nullptr);
@@ -54,7 +374,7 @@ int main() {
         int V = nL + nR;
         long long E = 1LL * nL * nR;
 
-        Kuhn solver;
+        KuhnLists solver;
         solver.init(V);
 
         for (int i = 1; i <= nL; ++i)
@@ -77,5 +397,12 @@ int main() {
                   << std::scientific << std::setprecision(6) << time_per << "\n";
     }
 
+    bench_engines();
+    bench_kuhn_options();
+    bench_parallel();
+    fuzz_dynamic();
+    bench_assignment();
+    bench_layout();
+
     return 0;
 }